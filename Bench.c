@@ -0,0 +1,557 @@
+/*
+ * ===============================================
+ *      Benchmarks beyond the main time loop
+ * ===============================================
+ */
+
+#include "Bench.h"
+
+// Number of different arrays each benchmark averages over
+#define BENCH_TESTS 10
+// Largest length the two-way engines are timed at in bench_distinct : with few distinct
+// values they degrade to quadratic time and linear recursion depth
+#define BENCH_QUADRATIC_MAX 20000
+// Length of the sample stored in the column files bench_column_write creates
+#define BENCH_COLUMN_SAMPLE 4096
+
+// Increasing order of ints for qsort
+static int bench_compare(const void *a, const void *b) {
+
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+// Fills the array with random values in [-arrLen/2, arrLen/2], same as main's default generator
+// The seed is drawn from rand(), seeded by main
+void bench_fill_random(int *arr, int arrLen) {
+
+    GenParams params;
+    gen_default_params(&params);
+    gen_fill(arr, arrLen, distUniform, &params, ((uint64_t)rand() << 31) ^ (uint64_t)rand());
+}
+
+// Compares the partition kernels head to head on the same arrays
+// Kernels not supported by the CPU are reported as "-"
+void bench_partition_kernels(int arrLen) {
+
+    const char *names[] = {"scalar", "block", "avx2", "avx512"};
+    int (*kernels[])(int *, int, int, int) = {kernel_select_scalar, kernel_select_block,
+                                             kernel_select_avx2, kernel_select_avx512};
+    double_t timings[4] = {0, 0, 0, 0};
+    int kth = arrLen / 2;
+    int *arr = malloc(arrLen * sizeof(int));
+
+    for (int i = 0; i < BENCH_TESTS; i++) {
+        bench_fill_random(arr, arrLen);
+        for (int j = 0; j < 4; j++) {
+            if (partition_supported((enum partitionKernel)j))
+                timings[j] += compute_selection_timings(kernels[j], arr, arrLen, kth);
+        }
+    }
+
+    printf("N : %d\tK : %d", arrLen, kth);
+    for (int j = 0; j < 4; j++) {
+        if (partition_supported((enum partitionKernel)j))
+            printf("\t%s : %0.9lf", names[j], timings[j] / BENCH_TESTS);
+        else
+            printf("\t%s : -", names[j]);
+    }
+    printf("\n");
+
+    free(arr);
+}
+
+// Reports the speedup of parallel_select against quick_select for 1, 2, 4 ... maxThreads threads
+// maxThreads <= 0 means every online core
+void bench_parallel_scaling(int arrLen, int maxThreads) {
+
+    int kth = arrLen / 2;
+    int *arr = malloc(arrLen * sizeof(int));
+
+    if (maxThreads <= 0) {
+        parallel_set_threads(0);
+        maxThreads = parallel_get_threads();
+    }
+
+    bench_fill_random(arr, arrLen);
+    double_t quickTime = compute_selection_timings(quick_select, arr, arrLen, kth);
+    printf("N : %d\tK : %d\tquick_select : %0.9lf\n", arrLen, kth, quickTime);
+
+    for (int threads = 1; ; threads *= 2) {
+        if (threads > maxThreads)
+            threads = maxThreads;
+
+        parallel_set_threads(threads);
+        double_t parallelTime = 0;
+        for (int i = 0; i < BENCH_TESTS; i++) {
+            parallelTime += compute_selection_timings(parallel_select, arr, arrLen, kth);
+        }
+        parallelTime /= BENCH_TESTS;
+        printf("Threads : %d\tparallel_select : %0.9lf\tSpeedup : %0.2lf\n",
+               threads, parallelTime, quickTime / parallelTime);
+
+        if (threads == maxThreads)
+            break;
+    }
+
+    free(arr);
+}
+
+// Compares heap_select on the binary Heap and on the d-ary heap for n = minLen, 10 * minLen ... maxLen
+void bench_heap_backends(int minLen, int maxLen) {
+
+    for (long arrLen = minLen; arrLen <= maxLen; arrLen *= 10) {
+
+        int n = (int)arrLen;
+        int kth = n / 2;
+        // Very large arrays take seconds per call : a single array is enough
+        int tests = n >= 1000000 ? 1 : BENCH_TESTS;
+        int *arr = malloc(n * sizeof(int));
+        double_t binaryTime = 0;
+        double_t daryTime = 0;
+
+        for (int i = 0; i < tests; i++) {
+            bench_fill_random(arr, n);
+            heap_set_backend(binaryHeap);
+            binaryTime += compute_selection_timings(heap_select, arr, n, kth);
+            heap_set_backend(daryHeap);
+            daryTime += compute_selection_timings(heap_select, arr, n, kth);
+        }
+        heap_set_backend(binaryHeap);
+
+        printf("N : %d\tK : %d\tbinary : %0.9lf\tdary : %0.9lf\tSpeedup : %0.2lf\n",
+               n, kth, binaryTime / tests, daryTime / tests, binaryTime / daryTime);
+        free(arr);
+    }
+}
+
+// Compares heap_select with heap_select_pooled (shared pre-sized arena)
+// Reports the time and the number of heap allocations of a single call of each
+void bench_heap_arena(int arrLen) {
+
+    int kth = arrLen / 2;
+    int *arr = malloc(arrLen * sizeof(int));
+    double_t heapTime = 0;
+    double_t arenaTime = 0;
+
+    for (int i = 0; i < BENCH_TESTS; i++) {
+        bench_fill_random(arr, arrLen);
+        heapTime += compute_selection_timings(heap_select, arr, arrLen, kth);
+        arenaTime += compute_selection_timings(heap_select_pooled, arr, arrLen, kth);
+    }
+
+    long before = heap_alloc_count();
+    heap_select(arr, arrLen, kth, 0);
+    long heapAllocs = heap_alloc_count() - before;
+
+    before = heap_alloc_count();
+    heap_select_pooled(arr, arrLen, kth, 0);
+    long arenaAllocs = heap_alloc_count() - before;
+
+    printf("N : %d\tK : %d\theap : %0.9lf\tallocs : %ld\tarena : %0.9lf\tallocs : %ld\n",
+           arrLen, kth, heapTime / BENCH_TESTS, heapAllocs, arenaTime / BENCH_TESTS, arenaAllocs);
+    free(arr);
+}
+
+// k used by bench_sketch_select
+int benchSketchK = 0;
+
+// Timing wrapper : builds a sketch of the whole array and queries its kth value
+// Mode 1 only initializes and frees the sketch
+static int bench_sketch_select(int *arr, int arrLen, int kth, int mode) {
+
+    QuantileSketch sk;
+    int result = 0;
+
+    sketch_init(&sk, benchSketchK);
+    if (mode == 0) {
+        sketch_insert_batch(&sk, arr, arrLen);
+        result = sketch_select(&sk, kth);
+    }
+    sketch_free(&sk);
+    return result;
+}
+
+// Compares the KLL sketch (rank error eps) with quick_select on the arrays main generates
+// Error : distance between k and the exact rank range of the returned value, divided by n
+void bench_sketch(int arrLen, double eps) {
+
+    int kth = arrLen / 2;
+    int *arr = malloc(arrLen * sizeof(int));
+    double_t quickTime = 0;
+    double_t sketchTime = 0;
+    double worstError = 0;
+    long memory = 0;
+
+    benchSketchK = sketch_k_for_error(eps);
+
+    for (int i = 0; i < BENCH_TESTS; i++) {
+        bench_fill_random(arr, arrLen);
+        quickTime += compute_selection_timings(quick_select, arr, arrLen, kth);
+        sketchTime += compute_selection_timings(bench_sketch_select, arr, arrLen, kth);
+
+        QuantileSketch sk;
+        sketch_init(&sk, benchSketchK);
+        sketch_insert_batch(&sk, arr, arrLen);
+        int value = sketch_select(&sk, kth);
+        memory = sketch_memory_bytes(&sk);
+        sketch_free(&sk);
+
+        long less = 0, lessEqual = 0;
+        for (int m = 0; m < arrLen; m++) {
+            less += (arr[m] < value);
+            lessEqual += (arr[m] <= value);
+        }
+        long error = 0;
+        if (kth <= less)
+            error = less + 1 - kth;
+        else if (kth > lessEqual)
+            error = kth - lessEqual;
+        if ((double)error / arrLen > worstError)
+            worstError = (double)error / arrLen;
+    }
+
+    printf("N : %d\tK : %d\tquick_select : %0.9lf\tsketch : %0.9lf\tError : %0.6lf\tMemory : %0.1lf KB\n",
+           arrLen, kth, quickTime / BENCH_TESTS, sketchTime / BENCH_TESTS, worstError, memory / 1024.0);
+    free(arr);
+}
+
+// Compares two-way and three-way partitioning on arrays holding 2, 16 and 1024 distinct values
+// Two-way engines are reported as "-" above BENCH_QUADRATIC_MAX
+void bench_distinct(int arrLen) {
+
+    const char *names[] = {"quick_select", "quick_select3", "median_select", "median_select3", "intro_select"};
+    int (*selectors[])(int *, int, int, int) = {quick_select, quick_select3, median_select,
+                                               median_select3, intro_select};
+    int twoWay[] = {1, 0, 1, 0, 0};
+    int distinct[] = {2, 16, 1024};
+    int kth = arrLen / 2;
+    int *arr = malloc(arrLen * sizeof(int));
+    GenParams params;
+    gen_default_params(&params);
+
+    for (int d = 0; d < 3; d++) {
+        double_t timings[5] = {0, 0, 0, 0, 0};
+        for (int i = 0; i < BENCH_TESTS; i++) {
+            params.uniques = distinct[d];
+            gen_fill(arr, arrLen, distFewUnique, &params, ((uint64_t)rand() << 31) ^ (uint64_t)rand());
+            for (int j = 0; j < 5; j++) {
+                if (!twoWay[j] || arrLen <= BENCH_QUADRATIC_MAX)
+                    timings[j] += compute_selection_timings(selectors[j], arr, arrLen, kth);
+            }
+        }
+
+        printf("N : %d\tK : %d\tDistinct : %d", arrLen, kth, distinct[d]);
+        for (int j = 0; j < 5; j++) {
+            if (!twoWay[j] || arrLen <= BENCH_QUADRATIC_MAX)
+                printf("\t%s : %0.9lf", names[j], timings[j] / BENCH_TESTS);
+            else
+                printf("\t%s : -", names[j]);
+        }
+        printf("\n");
+    }
+    free(arr);
+}
+
+// Maps a column file and runs each selector once directly on the mapping
+// Open : time to map and validate the file; the first selector also pays the page faults
+void bench_column(const char *path, int kth) {
+
+    const char *names[] = {"quick_select", "median_select", "heap_select", "intro_select"};
+    int (*selectors[])(int *, int, int, int) = {quick_select, median_select, heap_select, intro_select};
+    struct timespec tick, tock;
+    ColumnFile cf;
+
+    clock_gettime(CLOCK_MONOTONIC, &tick);
+    int opened = column_open(path, &cf);
+    clock_gettime(CLOCK_MONOTONIC, &tock);
+    if (!opened) {
+        fprintf(stderr, "%s is not a column file\n", path);
+        return;
+    }
+
+    int *arr = column_ints(&cf);
+    int arrLen = (int)cf.header.count;
+    if (arr == NULL || kth < 1 || kth > arrLen) {
+        fprintf(stderr, "%s is not an int32 column or K is out of range\n", path);
+        column_close(&cf);
+        return;
+    }
+
+    printf("N : %d\tK : %d\tOpen : %0.9lf", arrLen, kth, compute_execTime(tick, tock));
+    for (int j = 0; j < 4; j++) {
+        clock_gettime(CLOCK_MONOTONIC, &tick);
+        int result = selectors[j](arr, arrLen, kth, 0);
+        clock_gettime(CLOCK_MONOTONIC, &tock);
+        printf("\t%s : %d (%0.9lf)", names[j], result, compute_execTime(tick, tock));
+    }
+    printf("\n");
+    column_close(&cf);
+}
+
+// Writes arrLen values from main's generator to a column file with a stored sample
+void bench_column_write(const char *path, int arrLen) {
+
+    int *arr = malloc(arrLen * sizeof(int));
+    bench_fill_random(arr, arrLen);
+    if (!column_write(path, columnInt32, arr, arrLen, BENCH_COLUMN_SAMPLE))
+        fprintf(stderr, "Cannot write %s\n", path);
+    free(arr);
+}
+
+// Compares a quick_select per group with segmented_select on 1 thread and on every online core
+// Group lengths are uniform in [1, 2 * avgLen - 1], each group asks for its median
+void bench_segmented(int groups, int avgLen) {
+
+    long *offsets = malloc((groups + 1) * sizeof(long));
+    int *ks = malloc(groups * sizeof(int));
+    int *expected = malloc(groups * sizeof(int));
+    int *out = malloc(groups * sizeof(int));
+    GenRng rng;
+    gen_seed(&rng, ((uint64_t)rand() << 31) ^ (uint64_t)rand());
+
+    offsets[0] = 0;
+    for (int g = 0; g < groups; g++) {
+        long len = 1 + (long)gen_bounded(&rng, 2 * (uint64_t)avgLen - 1);
+        offsets[g + 1] = offsets[g] + len;
+        ks[g] = (int)((len + 1) / 2);
+    }
+    long total = offsets[groups];
+    int *values = malloc(total * sizeof(int));
+    GenParams params;
+    gen_default_params(&params);
+    gen_fill(values, (int)total, distUniform, &params, gen_next(&rng));
+
+    struct timespec tick, tock;
+    clock_gettime(CLOCK_MONOTONIC, &tick);
+    for (int g = 0; g < groups; g++) {
+        expected[g] = quick_select(values + offsets[g], (int)(offsets[g + 1] - offsets[g]), ks[g], 0);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &tock);
+    double_t loopTime = compute_execTime(tick, tock);
+    printf("Groups : %d\tValues : %ld\tquick_select loop : %0.9lf\n", groups, total, loopTime);
+
+    parallel_set_threads(0);
+    int threads[] = {1, parallel_get_threads()};
+    for (int t = 0; t < 2; t++) {
+        if (t == 1 && threads[1] == 1)
+            break;
+        parallel_set_threads(threads[t]);
+        clock_gettime(CLOCK_MONOTONIC, &tick);
+        segmented_select(values, offsets, groups, ks, out);
+        clock_gettime(CLOCK_MONOTONIC, &tock);
+        double_t segmentedTime = compute_execTime(tick, tock);
+        int mismatches = 0;
+        for (int g = 0; g < groups; g++) {
+            mismatches += out[g] != expected[g];
+        }
+        printf("Threads : %d\tsegmented_select : %0.9lf\tSpeedup : %0.2lf\tMismatches : %d\n",
+               threads[t], segmentedTime, loopTime / segmentedTime, mismatches);
+    }
+
+    free(values);
+    free(out);
+    free(expected);
+    free(ks);
+    free(offsets);
+}
+
+// Compares top_k_heap, top_k_partition and a full qsort for the k smallest sorted values,
+// k going from 10 to arrLen / 2, and checks that the three agree
+void bench_top(int arrLen) {
+
+    int ks[] = {10, 100, 1000, arrLen / 100, arrLen / 10, arrLen / 2};
+    int *arr = malloc(arrLen * sizeof(int));
+    int *sorted = malloc(arrLen * sizeof(int));
+    int *out = malloc(arrLen * sizeof(int));
+    struct timespec tick, tock;
+
+    for (int j = 0; j < 6; j++) {
+        int k = ks[j];
+        if (k < 1 || k > arrLen || (j > 0 && k <= ks[j - 1]))
+            continue;
+        double_t heapTime = 0, partitionTime = 0, sortTime = 0;
+        int mismatches = 0;
+
+        for (int i = 0; i < BENCH_TESTS; i++) {
+            bench_fill_random(arr, arrLen);
+
+            clock_gettime(CLOCK_MONOTONIC, &tick);
+            memcpy(sorted, arr, arrLen * sizeof(int));
+            qsort(sorted, arrLen, sizeof(int), bench_compare);
+            clock_gettime(CLOCK_MONOTONIC, &tock);
+            sortTime += compute_execTime(tick, tock);
+
+            clock_gettime(CLOCK_MONOTONIC, &tick);
+            top_k_heap(arr, arrLen, k, 0, topSorted, out);
+            clock_gettime(CLOCK_MONOTONIC, &tock);
+            heapTime += compute_execTime(tick, tock);
+            mismatches += memcmp(out, sorted, k * sizeof(int)) != 0;
+
+            clock_gettime(CLOCK_MONOTONIC, &tick);
+            top_k_partition(arr, arrLen, k, 0, topSorted, out);
+            clock_gettime(CLOCK_MONOTONIC, &tock);
+            partitionTime += compute_execTime(tick, tock);
+            mismatches += memcmp(out, sorted, k * sizeof(int)) != 0;
+        }
+
+        printf("N : %d\tK : %d\tqsort : %0.9lf\theap : %0.9lf\tpartition : %0.9lf\tMismatches : %d\n",
+               arrLen, k, sortTime / BENCH_TESTS, heapTime / BENCH_TESTS, partitionTime / BENCH_TESTS, mismatches);
+    }
+
+    free(out);
+    free(sorted);
+    free(arr);
+}
+
+// Answers the same random ranks with quick_select and with a SelectIndex built on the array
+// Reports the cumulative time of both after 1, 10, 100 ... queries, the index including its copy,
+// and the share of positions the index has settled
+void bench_index(int arrLen, int queries) {
+
+    int *arr = malloc(arrLen * sizeof(int));
+    GenRng rng;
+    SelectIndex idx;
+    struct timespec tick, tock;
+    double_t quickTime = 0, indexTime = 0;
+    int mismatches = 0;
+
+    bench_fill_random(arr, arrLen);
+    gen_seed(&rng, ((uint64_t)rand() << 31) ^ (uint64_t)rand());
+
+    clock_gettime(CLOCK_MONOTONIC, &tick);
+    select_index_init(&idx, arr, arrLen);
+    clock_gettime(CLOCK_MONOTONIC, &tock);
+    indexTime += compute_execTime(tick, tock);
+
+    for (int q = 1, report = 1; q <= queries; q++) {
+        int kth = 1 + (int)gen_bounded(&rng, arrLen);
+
+        clock_gettime(CLOCK_MONOTONIC, &tick);
+        int expected = quick_select(arr, arrLen, kth, 0);
+        clock_gettime(CLOCK_MONOTONIC, &tock);
+        quickTime += compute_execTime(tick, tock);
+
+        clock_gettime(CLOCK_MONOTONIC, &tick);
+        int result = select_index_kth(&idx, kth);
+        clock_gettime(CLOCK_MONOTONIC, &tock);
+        indexTime += compute_execTime(tick, tock);
+        mismatches += result != expected;
+
+        if (q == report || q == queries) {
+            printf("N : %d\tQueries : %d\tquick_select : %0.9lf\tindex : %0.9lf\tSettled : %0.2lf%%\tMismatches : %d\n",
+                   arrLen, q, quickTime, indexTime, 100.0 * select_index_settled(&idx) / arrLen, mismatches);
+            report *= 10;
+        }
+    }
+
+    select_index_free(&idx);
+    free(arr);
+}
+
+// Mixed workload on an array of arrLen values : each step replaces a random value
+// and asks for a random rank
+// The OrderTree applies the update in place, the selectors run again on the whole array,
+// so they only take the first BENCH_TESTS steps
+// Times are per step; the tree's build is reported apart
+void bench_order(int arrLen, int steps) {
+
+    const char *names[] = {"quick_select", "heap_select", "intro_select"};
+    int (*selectors[])(int *, int, int, int) = {quick_select, heap_select, intro_select};
+    double_t timings[3] = {0, 0, 0};
+    int *arr = malloc(arrLen * sizeof(int));
+    int *expected = malloc(BENCH_TESTS * sizeof(int));
+    int selectorSteps = steps < BENCH_TESTS ? steps : BENCH_TESTS;
+    int mismatches = 0;
+    GenRng rng;
+    OrderTree tree;
+    struct timespec tick, tock;
+
+    bench_fill_random(arr, arrLen);
+    gen_seed(&rng, ((uint64_t)rand() << 31) ^ (uint64_t)rand());
+    uint64_t stepSeed = gen_next(&rng);
+
+    clock_gettime(CLOCK_MONOTONIC, &tick);
+    order_tree_init(&tree, arrLen);
+    order_tree_build(&tree, arr, arrLen);
+    clock_gettime(CLOCK_MONOTONIC, &tock);
+    double_t buildTime = compute_execTime(tick, tock);
+
+    // Selectors first, on a copy of the updates the tree replays below
+    int *work = malloc(arrLen * sizeof(int));
+    memcpy(work, arr, arrLen * sizeof(int));
+    gen_seed(&rng, stepSeed);
+    for (int s = 0; s < selectorSteps; s++) {
+        int i = (int)gen_bounded(&rng, arrLen);
+        work[i] = (int)gen_bounded(&rng, arrLen) - arrLen / 2;
+        int kth = 1 + (int)gen_bounded(&rng, arrLen);
+        for (int j = 0; j < 3; j++) {
+            clock_gettime(CLOCK_MONOTONIC, &tick);
+            int result = selectors[j](work, arrLen, kth, 0);
+            clock_gettime(CLOCK_MONOTONIC, &tock);
+            timings[j] += compute_execTime(tick, tock);
+            if (j == 0)
+                expected[s] = result;
+            else
+                mismatches += result != expected[s];
+        }
+    }
+
+    gen_seed(&rng, stepSeed);
+    clock_gettime(CLOCK_MONOTONIC, &tick);
+    for (int s = 0; s < steps; s++) {
+        int i = (int)gen_bounded(&rng, arrLen);
+        int value = (int)gen_bounded(&rng, arrLen) - arrLen / 2;
+        order_tree_erase(&tree, arr[i]);
+        order_tree_insert(&tree, value);
+        arr[i] = value;
+        int result = order_tree_kth(&tree, 1 + (int)gen_bounded(&rng, arrLen));
+        if (s < selectorSteps)
+            mismatches += result != expected[s];
+    }
+    clock_gettime(CLOCK_MONOTONIC, &tock);
+    double_t treeTime = compute_execTime(tick, tock);
+
+    printf("N : %d\tSteps : %d\tbuild : %0.9lf\torder_tree : %0.9lf", arrLen, steps, buildTime, treeTime / steps);
+    for (int j = 0; j < 3; j++) {
+        printf("\t%s : %0.9lf", names[j], timings[j] / selectorSteps);
+    }
+    printf("\tMismatches : %d\n", mismatches);
+
+    order_tree_free(&tree);
+    free(work);
+    free(expected);
+    free(arr);
+}
+
+// Compares radix_select with quick_select and intro_select on values in [-range, range],
+// range going from the [-n/2, n/2] of main to the whole int range
+void bench_radix(int arrLen) {
+
+    const char *names[] = {"quick_select", "intro_select", "radix_select"};
+    int (*selectors[])(int *, int, int, int) = {quick_select, intro_select, radix_select};
+    long long ranges[] = {0, 1000, 1 << 20, INT_MAX};
+    int kth = arrLen / 2;
+    int *arr = malloc(arrLen * sizeof(int));
+    GenParams params;
+    gen_default_params(&params);
+
+    for (int g = 0; g < 4; g++) {
+        double_t timings[3] = {0, 0, 0};
+        params.range = ranges[g];
+        for (int i = 0; i < BENCH_TESTS; i++) {
+            gen_fill(arr, arrLen, distUniform, &params, ((uint64_t)rand() << 31) ^ (uint64_t)rand());
+            for (int j = 0; j < 3; j++) {
+                timings[j] += compute_selection_timings(selectors[j], arr, arrLen, kth);
+            }
+        }
+
+        printf("N : %d\tK : %d\tRange : %lld", arrLen, kth, ranges[g] != 0 ? ranges[g] : (long long)arrLen / 2);
+        for (int j = 0; j < 3; j++) {
+            printf("\t%s : %0.9lf", names[j], timings[j] / BENCH_TESTS);
+        }
+        printf("\n");
+    }
+    free(arr);
+}
@@ -0,0 +1,32 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <limits.h>
+#include "Time.h"
+#include "PartitionKernels.h"
+#include "ParallelSelect.h"
+#include "QuantileSketch.h"
+#include "ColumnFile.h"
+#include "Generator.h"
+#include "SegmentedSelect.h"
+#include "TopSelect.h"
+#include "SelectIndex.h"
+#include "OrderTree.h"
+#include "RadixSelect.h"
+
+void bench_fill_random(int *, int);
+void bench_partition_kernels(int);
+void bench_parallel_scaling(int, int);
+void bench_heap_backends(int, int);
+void bench_heap_arena(int);
+void bench_sketch(int, double);
+void bench_distinct(int);
+void bench_column(const char *, int);
+void bench_column_write(const char *, int);
+void bench_segmented(int, int);
+void bench_top(int);
+void bench_index(int, int);
+void bench_order(int, int);
+void bench_radix(int);
+
+#endif // BENCH_H
@@ -0,0 +1,216 @@
+/*
+ * ===============================================
+ *     Binary Column Files : Writer and Reader
+ * ===============================================
+ */
+
+#include "ColumnFile.h"
+#include "StreamSelect.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// The column is stored little-endian and read in place, so only little-endian hosts are supported
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "ColumnFile reads columns in place and requires a little-endian host"
+#endif
+
+static int column_compare(const void *a, const void *b) {
+
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+size_t column_type_size(enum columnType type) {
+
+    switch (type) {
+        case columnInt32:
+        case columnFloat32:
+            return 4;
+        case columnInt64:
+        case columnFloat64:
+            return 8;
+    }
+    return 0;
+}
+
+static uint64_t column_data_offset(uint32_t sampleLen) {
+
+    uint64_t end = sizeof(ColumnHeader) + (uint64_t)sampleLen * sizeof(int);
+    return (end + COLUMN_ALIGN - 1) / COLUMN_ALIGN * COLUMN_ALIGN;
+}
+
+// Writes header, sample and padding, leaving fp at the start of the column
+static int column_write_header(FILE *fp, ColumnHeader *header, const int *sample) {
+
+    static const char zeros[COLUMN_ALIGN] = {0};
+    long padding = (long)(header->dataOffset - sizeof(ColumnHeader) - header->sampleLen * sizeof(int));
+
+    if (fwrite(header, sizeof(ColumnHeader), 1, fp) != 1)
+        return 0;
+    if (header->sampleLen > 0 && fwrite(sample, sizeof(int), header->sampleLen, fp) != header->sampleLen)
+        return 0;
+    return padding == 0 || fwrite(zeros, 1, padding, fp) == (size_t)padding;
+}
+
+// Writes count elements of the given type to a column file
+// For int32 columns, sampleLen values taken at evenly spaced positions are stored sorted in the
+// header, so that selectors can choose pivots without touching the column
+// Returns 1 on success
+int column_write(const char *path, enum columnType type, const void *data, uint64_t count, uint32_t sampleLen) {
+
+    size_t size = column_type_size(type);
+    if (size == 0)
+        return 0;
+    if (type != columnInt32 || count == 0)
+        sampleLen = 0;
+    if (sampleLen > count)
+        sampleLen = (uint32_t)count;
+
+    int *sample = malloc((sampleLen > 0 ? sampleLen : 1) * sizeof(int));
+    for (uint32_t i = 0; i < sampleLen; i++) {
+        sample[i] = ((const int *)data)[(uint64_t)i * count / sampleLen];
+    }
+    qsort(sample, sampleLen, sizeof(int), column_compare);
+
+    ColumnHeader header;
+    memcpy(header.magic, COLUMN_MAGIC, sizeof(header.magic));
+    header.type = type;
+    header.sampleLen = sampleLen;
+    header.count = count;
+    header.dataOffset = column_data_offset(sampleLen);
+
+    FILE *fp = fopen(path, "wb");
+    int ok = fp != NULL && column_write_header(fp, &header, sample)
+             && fwrite(data, size, count, fp) == count;
+    if (fp != NULL && fclose(fp) != 0)
+        ok = 0;
+
+    free(sample);
+    return ok;
+}
+
+// Converts whitespace separated ints read from fp into an int32 column file
+// The count is patched into the header once the input is exhausted; the sample is a reservoir
+// sample of the whole input
+// Returns 1 on success
+int column_write_stream(const char *path, FILE *in, uint32_t sampleLen) {
+
+    FILE *fp = fopen(path, "wb");
+    if (fp == NULL)
+        return 0;
+
+    ColumnHeader header;
+    memcpy(header.magic, COLUMN_MAGIC, sizeof(header.magic));
+    header.type = columnInt32;
+    header.sampleLen = sampleLen;
+    header.count = 0;
+    header.dataOffset = column_data_offset(sampleLen);
+
+    int *sample = calloc(sampleLen > 0 ? sampleLen : 1, sizeof(int));
+    int ok = column_write_header(fp, &header, sample);
+
+    StreamReader *reader = malloc(sizeof(StreamReader));
+    stream_reader_init(reader, in);
+    unsigned long long state = 0x9E3779B97F4A7C15ULL;
+    int values[1024];
+    int len = 0;
+    int value;
+
+    while (ok && stream_next_int(reader, &value)) {
+        if (header.count < sampleLen) {
+            sample[header.count] = value;
+        } else if (sampleLen > 0) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            uint64_t slot = state % (header.count + 1);
+            if (slot < sampleLen)
+                sample[slot] = value;
+        }
+        header.count++;
+        values[len++] = value;
+        if (len == 1024) {
+            ok = fwrite(values, sizeof(int), len, fp) == (size_t)len;
+            len = 0;
+        }
+    }
+    if (ok && len > 0)
+        ok = fwrite(values, sizeof(int), len, fp) == (size_t)len;
+
+    // Inputs shorter than the sample keep only the values read
+    if (header.count < sampleLen)
+        header.sampleLen = (uint32_t)header.count;
+    qsort(sample, header.sampleLen, sizeof(int), column_compare);
+
+    if (ok) {
+        // The data offset was fixed by the requested sample length, only the header fields change
+        ok = fseek(fp, 0, SEEK_SET) == 0 && fwrite(&header, sizeof(ColumnHeader), 1, fp) == 1
+             && fwrite(sample, sizeof(int), header.sampleLen, fp) == header.sampleLen;
+    }
+    if (fclose(fp) != 0)
+        ok = 0;
+
+    free(reader);
+    free(sample);
+    return ok;
+}
+
+// Maps a column file without reading it
+// The mapping is private and writable : the selectors that work on a copy read the pages in place,
+// and the in-place variants only copy the pages they actually modify
+// Returns 1 on success, 0 if the file cannot be mapped or is not a valid column file
+int column_open(const char *path, ColumnFile *cf) {
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return 0;
+
+    struct stat st;
+    if (fstat(fd, &st) < 0 || (size_t)st.st_size < sizeof(ColumnHeader)) {
+        close(fd);
+        return 0;
+    }
+
+    void *map = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return 0;
+
+    memcpy(&cf->header, map, sizeof(ColumnHeader));
+    ColumnHeader *header = &cf->header;
+    size_t size = column_type_size((enum columnType)header->type);
+    if (memcmp(header->magic, COLUMN_MAGIC, sizeof(header->magic)) != 0 || size == 0
+        || header->dataOffset < sizeof(ColumnHeader) + (uint64_t)header->sampleLen * sizeof(int)
+        || header->dataOffset > (uint64_t)st.st_size
+        || header->count > ((uint64_t)st.st_size - header->dataOffset) / size) {
+        munmap(map, st.st_size);
+        return 0;
+    }
+
+    cf->map = map;
+    cf->mapLen = st.st_size;
+    cf->data = (const char *)map + header->dataOffset;
+    cf->sample = header->sampleLen > 0 ? (const int *)((const char *)map + sizeof(ColumnHeader)) : NULL;
+    madvise((char *)map + header->dataOffset, header->count * size, MADV_SEQUENTIAL);
+    return 1;
+}
+
+// Returns the column as an int array for the int selectors, NULL if it is not an int32 column
+// or holds more values than an int can index
+int *column_ints(ColumnFile *cf) {
+
+    if (cf->header.type != columnInt32 || cf->header.count > INT32_MAX)
+        return NULL;
+    return (int *)cf->data;
+}
+
+void column_close(ColumnFile *cf) {
+
+    munmap(cf->map, cf->mapLen);
+    cf->map = NULL;
+    cf->data = NULL;
+    cf->sample = NULL;
+}
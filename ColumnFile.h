@@ -0,0 +1,39 @@
+#ifndef COLUMN_FILE_H
+#define COLUMN_FILE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+// File layout : header, optional sorted sample of int32 values, padding to a page boundary,
+// then the raw little-endian column starting at dataOffset
+#define COLUMN_MAGIC "SELCOL01"
+#define COLUMN_ALIGN 4096
+
+enum columnType {columnInt32 = 1, columnInt64, columnFloat32, columnFloat64};
+
+struct _columnHeader {
+    char     magic[8];
+    uint32_t type;
+    uint32_t sampleLen;
+    uint64_t count;
+    uint64_t dataOffset;
+}; typedef struct _columnHeader ColumnHeader;
+
+struct _columnFile {
+    ColumnHeader header;
+    void        *map;
+    size_t       mapLen;
+    const void  *data;      // first element of the column, page aligned
+    const int   *sample;    // sorted sample of an int32 column, NULL if absent
+}; typedef struct _columnFile ColumnFile;
+
+size_t column_type_size(enum columnType);
+int    column_write(const char *, enum columnType, const void *, uint64_t, uint32_t);
+int    column_write_stream(const char *, FILE *, uint32_t);
+int    column_open(const char *, ColumnFile *);
+int   *column_ints(ColumnFile *);
+void   column_close(ColumnFile *);
+
+#endif // COLUMN_FILE_H
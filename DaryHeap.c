@@ -0,0 +1,87 @@
+/*
+ * ===============================================
+ *      Implementation of the d-ary SoA Heap
+ * ===============================================
+ */
+
+#include "DaryHeap.h"
+
+#define DARY_LINE 64
+// Slots skipped at the start of "values" so that child groups are aligned on DARY_ARITY ints
+#define DARY_OFFSET (DARY_ARITY - 1)
+
+// Returns a DARY_LINE-aligned block able to hold "count" ints after DARY_OFFSET padding slots
+static int *dary_alloc(int count) {
+
+    size_t bytes = (size_t)(count + DARY_OFFSET) * sizeof(int);
+    bytes = (bytes + DARY_LINE - 1) / DARY_LINE * DARY_LINE;
+    return aligned_alloc(DARY_LINE, bytes);
+}
+
+// Initializes an empty heap able to hold "capacity" values, it is never resized
+void dary_init(DaryHeap *hp, int capacity) {
+
+    hp->valuesBlock = dary_alloc(capacity);
+    hp->indicesBlock = dary_alloc(capacity);
+    hp->values = hp->valuesBlock + DARY_OFFSET;
+    hp->indices = hp->indicesBlock + DARY_OFFSET;
+    hp->size = 0;
+    hp->capacity = capacity;
+}
+
+void dary_free(DaryHeap *hp) {
+
+    free(hp->valuesBlock);
+    free(hp->indicesBlock);
+}
+
+#define DARY_NAME   min
+#define DARY_BEFORE(a, b) ((a) < (b))
+#include "DaryHeapImpl.h"
+#undef DARY_NAME
+#undef DARY_BEFORE
+
+#define DARY_NAME   max
+#define DARY_BEFORE(a, b) ((a) > (b))
+#include "DaryHeapImpl.h"
+#undef DARY_NAME
+#undef DARY_BEFORE
+
+// Selection algorithm of heap_select on top of the d-ary heap
+// Does not modify the vector
+int dary_select(int *arr, int arrLen, int kth, int mode){
+
+    int result = 0;
+    DaryHeap hp;
+    DaryHeap aux;
+
+    dary_init(&hp, arrLen);
+    memcpy(hp.values, arr, arrLen * sizeof(int));
+    hp.size = arrLen;
+
+    if (mode == 0) {
+        // Same choice of heapType as heap_select : the heap only has to walk through min(k, n - k + 1) values
+        int useMax = kth > arrLen / 2;
+        if (useMax)
+            kth = arrLen - kth + 1;
+
+        for (int i = 0; i < arrLen; i++) {
+            hp.indices[i] = i;
+        }
+        dary_init(&aux, kth + 1);
+
+        if (useMax) {
+            dary_heapify_max(&hp);
+            dary_push_max(&aux, hp.values[0], 0);
+            result = dary_rec_max(&hp, &aux, kth);
+        } else {
+            dary_heapify_min(&hp);
+            dary_push_min(&aux, hp.values[0], 0);
+            result = dary_rec_min(&hp, &aux, kth);
+        }
+        dary_free(&aux);
+    }
+
+    dary_free(&hp);
+    return result;
+}
@@ -0,0 +1,39 @@
+#ifndef DARY_HEAP_H
+#define DARY_HEAP_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Number of children of each node : 4 ints fill 16 bytes, so siblings never straddle a cache line
+#define DARY_ARITY 4
+
+// Heap stored as two parallel arrays (values and their indexes) instead of an array of Node
+// "values" is offset inside a 64-byte aligned block so that the children of any node,
+// ARITY * i + 1 ... ARITY * i + ARITY, start on a 16-byte boundary
+struct _daryHeap {
+    int *values;
+    int *indices;
+    int size;
+    int capacity;
+    int *valuesBlock;
+    int *indicesBlock;
+}; typedef struct _daryHeap DaryHeap;
+
+void dary_init(DaryHeap *, int);
+void dary_free(DaryHeap *);
+
+// Min and max versions are compiled separately, so no step of the sift loops tests the heap type
+void dary_heapify_min(DaryHeap *);
+void dary_push_min(DaryHeap *, int, int);
+void dary_pop_min(DaryHeap *);
+int  dary_rec_min(DaryHeap *, DaryHeap *, int);
+
+void dary_heapify_max(DaryHeap *);
+void dary_push_max(DaryHeap *, int, int);
+void dary_pop_max(DaryHeap *);
+int  dary_rec_max(DaryHeap *, DaryHeap *, int);
+
+int  dary_select(int *, int, int, int);
+
+#endif // DARY_HEAP_H
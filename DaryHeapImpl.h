@@ -0,0 +1,147 @@
+/*
+ * ===============================================
+ *      Template of the d-ary heap functions
+ * ===============================================
+ */
+
+// Included once per heap type by DaryHeap.c, after defining:
+// DARY_NAME   : suffix of every function (min or max)
+// DARY_BEFORE : "a must stay above b", expanded inline in the sift loops
+
+#define DARY_CAT_(a, b) a##_##b
+#define DARY_CAT(a, b)  DARY_CAT_(a, b)
+#define DARY_FN(name)   DARY_CAT(name, DARY_NAME)
+
+// Iterative heapify function ( going "downwards" )
+// Finds the best of the (up to) ARITY children, which share one cache line, then moves the hole down
+static void DARY_FN(dary_sift_down)(DaryHeap *hp, int index) {
+
+    int *values = hp->values;
+    int *indices = hp->indices;
+    int size = hp->size;
+    int value = values[index];
+    int position = indices[index];
+
+    for (;;) {
+        int first = DARY_ARITY * index + 1;
+        if (first >= size)
+            break;
+
+        int last = first + DARY_ARITY < size ? first + DARY_ARITY : size;
+        int best = first;
+        for (int child = first + 1; child < last; child++) {
+            if (DARY_BEFORE(values[child], values[best]))
+                best = child;
+        }
+        if (!DARY_BEFORE(values[best], value))
+            break;
+
+        values[index] = values[best];
+        indices[index] = indices[best];
+        index = best;
+    }
+    values[index] = value;
+    indices[index] = position;
+}
+
+// Iterative heapify function ( going "upwards" )
+static void DARY_FN(dary_sift_up)(DaryHeap *hp, int index) {
+
+    int *values = hp->values;
+    int *indices = hp->indices;
+    int value = values[index];
+    int position = indices[index];
+
+    while (index > 0) {
+        int parent = (index - 1) / DARY_ARITY;
+        if (!DARY_BEFORE(value, values[parent]))
+            break;
+        values[index] = values[parent];
+        indices[index] = indices[parent];
+        index = parent;
+    }
+    values[index] = value;
+    indices[index] = position;
+}
+
+void DARY_FN(dary_heapify)(DaryHeap *hp) {
+
+    for (int i = (hp->size - 2) / DARY_ARITY; i >= 0; --i) {
+        DARY_FN(dary_sift_down)(hp, i);
+    }
+}
+
+// Assumes the heap has room for one more value
+void DARY_FN(dary_push)(DaryHeap *hp, int value, int index) {
+
+    hp->values[hp->size] = value;
+    hp->indices[hp->size] = index;
+    DARY_FN(dary_sift_up)(hp, hp->size++);
+}
+
+void DARY_FN(dary_pop)(DaryHeap *hp) {
+
+    hp->size--;
+    hp->values[0] = hp->values[hp->size];
+    hp->indices[0] = hp->indices[hp->size];
+    if (hp->size > 0)
+        DARY_FN(dary_sift_down)(hp, 0);
+}
+
+// Returns the best position of the sibling group starting at "first" not yet pushed to aux, -1 if none
+// "pushed" holds one bit per position; the ARITY candidates share one cache line
+static inline int DARY_FN(dary_next_in_group)(DaryHeap *hp, unsigned char *pushed, int first) {
+
+    int last = first + DARY_ARITY < hp->size ? first + DARY_ARITY : hp->size;
+    int mask = pushed[first / DARY_ARITY];
+    int best = -1;
+
+    for (int c = first; c < last; c++) {
+        if (mask & (1 << (c - first)))
+            continue;
+        if (best == -1 || DARY_BEFORE(hp->values[c], hp->values[best]))
+            best = c;
+    }
+    if (best != -1)
+        pushed[first / DARY_ARITY] = (unsigned char)(mask | (1 << (best - first)));
+    return best;
+}
+
+// Same walk as heap_rec : the root of "aux" is extracted kth - 1 times and replaced by its successors in hp
+// Rather than pushing all ARITY children of an extracted node, aux only holds, for every sibling group
+// reached so far, its best value not extracted yet : an extraction pushes at most the next sibling of the
+// extracted node and the best of its children, so aux grows by one value per step as with heap_rec
+// Assumes hp has been heapify-ed, aux holds hp's root and has room for kth + 1 values
+int DARY_FN(dary_rec)(DaryHeap *hp, DaryHeap *aux, int kth) {
+
+    // One bit per position : which members of each sibling group (indexed by first / ARITY) reached aux
+    unsigned char *pushed = calloc(hp->size / DARY_ARITY + 2, 1);
+
+    for (int i = 0; i <= kth - 2; i++) {
+        int position = aux->indices[0];
+        int sibling = -1;
+        int child = -1;
+        if (position > 0)
+            sibling = DARY_FN(dary_next_in_group)(hp, pushed, (position - 1) / DARY_ARITY * DARY_ARITY + 1);
+        if (DARY_ARITY * position + 1 < hp->size)
+            child = DARY_FN(dary_next_in_group)(hp, pushed, DARY_ARITY * position + 1);
+
+        // The next sibling takes the place of the extracted root
+        if (sibling != -1) {
+            aux->values[0] = hp->values[sibling];
+            aux->indices[0] = sibling;
+            DARY_FN(dary_sift_down)(aux, 0);
+        } else {
+            DARY_FN(dary_pop)(aux);
+        }
+        if (child != -1)
+            DARY_FN(dary_push)(aux, hp->values[child], child);
+    }
+
+    free(pushed);
+    return aux->values[0];
+}
+
+#undef DARY_CAT_
+#undef DARY_CAT
+#undef DARY_FN
@@ -0,0 +1,871 @@
+/*
+ * ===============================================
+ *     Configurable Benchmark Driver for main
+ * ===============================================
+ */
+
+#define _GNU_SOURCE
+#include "Driver.h"
+#include <getopt.h>
+#include <sched.h>
+#include <limits.h>
+#include <time.h>
+
+#if defined(__clang__)
+#define DRIVER_COMPILER "clang " __VERSION__
+#elif defined(__GNUC__)
+#define DRIVER_COMPILER "gcc " __VERSION__
+#else
+#define DRIVER_COMPILER "unknown"
+#endif
+
+// Trials run again serially by --variance to measure the skew of parallel measurement
+#define DRIVER_VARIANCE_CHECKS 4
+// Spread or skew, in percent, above which --variance flags an algorithm
+#define DRIVER_SKEW_WARNING 5.0
+
+#define DRIVER_OPS 5
+static const char *driverOpNames[DRIVER_OPS] = {"comparisons", "swaps", "passes", "sift_steps", "max_depth"};
+
+static const DriverAlgorithm driverAlgorithms[] = {
+    {"quick",          quick_select},
+    {"heap",           heap_select},
+    {"median",         median_select},
+    {"intro",          intro_select},
+    {"floyd",          floyd_select},
+    {"quick3",         quick_select3},
+    {"median3",        median_select3},
+    // zero-copy variants, timed net of the copy into their reused scratch buffer
+    {"quick_scratch",  time_quick_scratch},
+    {"median_scratch", time_median_scratch},
+    {"heap_pooled",    heap_select_pooled},
+    {"dary",           dary_select},
+    {"kernel",         kernel_select_best},
+    {"parallel",       parallel_select},
+    {"radix",          radix_select},
+};
+#define DRIVER_ALGORITHMS_LEN ((int)(sizeof(driverAlgorithms) / sizeof(driverAlgorithms[0])))
+
+// Same progression, rank, tests and algorithms as the original hard-coded loop of main
+void driver_default_config(DriverConfig *config) {
+
+    memset(config, 0, sizeof(DriverConfig));
+    config->minLen = 100;
+    config->maxLen = 119;
+    config->step = 1;
+    config->quantile = 0.5;
+    config->sameTests = 100;
+    config->differentTests = 100;
+    config->copyOverhead = 1;
+    config->dist = distUniform;
+    gen_default_params(&config->params);
+    for (int i = 0; i < 5; i++) {
+        config->algorithms[i] = &driverAlgorithms[i];
+    }
+    config->algorithmsLen = 5;
+    config->format = formatTsv;
+    config->output = "results.txt";
+}
+
+void driver_usage(FILE *fp, const char *program) {
+
+    fprintf(fp,
+            "Usage : %s [options]\n"
+            "  --min N            smallest array length (100)\n"
+            "  --max N            largest array length, inclusive (119)\n"
+            "  --step N           linear progression step (1)\n"
+            "  --factor F         geometric progression factor, replaces --step\n"
+            "  --k K              absolute rank, at least 1, clamped to the array length\n"
+            "  --quantile Q       rank as a fraction of the array length (0.5)\n"
+            "  --dist D           input distribution among :",
+            program);
+    for (int i = 0; i < distCount; i++) {
+        fprintf(fp, " %s", gen_distribution_name((enum genDistribution)i));
+    }
+    fprintf(fp, "\n"
+            "                     (uniform)\n"
+            "  --range R          values drawn in [-R, R] (default [-n/2, n/2])\n"
+            "  --uniques U        distinct values of few-unique and zipf (16)\n"
+            "  --zipf S           exponent of zipf (1.0)\n"
+            "  --swaps P          random swaps of nearly-sorted, in percent of n (1.0)\n"
+            "  --algos A,B,...    algorithms among :");
+    for (int i = 0; i < DRIVER_ALGORITHMS_LEN; i++) {
+        fprintf(fp, " %s", driverAlgorithms[i].name);
+    }
+    fprintf(fp, "\n"
+            "                     (quick,heap,median,intro,floyd)\n"
+            "  --same N           repetitions on the same array (100)\n"
+            "  --different N      different arrays per length, at least 2 (100)\n"
+            "  --no-copy          skips the copy overhead columns\n"
+            "  --counters         adds hardware counters per element after each algorithm\n"
+            "  --ops              adds operation counts after each algorithm (built with -DSELECT_COUNT_OPS)\n"
+            "  --format F         tsv, csv or json (tsv)\n"
+            "  --output FILE      tsv is appended, csv and json overwrite, - for stdout (results.txt)\n"
+            "  --seed S           seed of the generator (default from /dev/urandom)\n"
+            "  --cores LIST       spreads the arrays over one pinned worker per core, e.g. 2,4-7\n"
+            "  --variance         with --cores, reports the cross-core spread and the skew against serial runs\n");
+}
+
+static const DriverAlgorithm *driver_find_algorithm(const char *name, size_t len) {
+
+    for (int i = 0; i < DRIVER_ALGORITHMS_LEN; i++) {
+        if (strlen(driverAlgorithms[i].name) == len && strncmp(driverAlgorithms[i].name, name, len) == 0)
+            return &driverAlgorithms[i];
+    }
+    return NULL;
+}
+
+static int driver_parse_algorithms(DriverConfig *config, const char *list) {
+
+    config->algorithmsLen = 0;
+    while (*list != '\0') {
+        size_t len = strcspn(list, ",");
+        const DriverAlgorithm *algorithm = driver_find_algorithm(list, len);
+        if (algorithm == NULL || config->algorithmsLen == DRIVER_MAX_ALGORITHMS) {
+            fprintf(stderr, "Unknown algorithm : %.*s\n", (int)len, list);
+            return 0;
+        }
+        config->algorithms[config->algorithmsLen++] = algorithm;
+        list += len;
+        if (*list == ',')
+            list++;
+    }
+    return config->algorithmsLen > 0;
+}
+
+// Parses a list of cores such as "0,2,4-7"
+static int driver_parse_cores(DriverConfig *config, const char *list) {
+
+    config->coresLen = 0;
+    while (*list != '\0') {
+        char *end;
+        long first = strtol(list, &end, 10);
+        long last = first;
+        if (end == list || first < 0)
+            return 0;
+        if (*end == '-') {
+            list = end + 1;
+            last = strtol(list, &end, 10);
+            if (end == list || last < first)
+                return 0;
+        }
+        for (long core = first; core <= last; core++) {
+            if (config->coresLen == DRIVER_MAX_CORES || core >= CPU_SETSIZE)
+                return 0;
+            config->cores[config->coresLen++] = (int)core;
+        }
+        list = end;
+        if (*list == ',')
+            list++;
+        else if (*list != '\0')
+            return 0;
+    }
+    return config->coresLen > 0;
+}
+
+// Fills the configuration from the command line, starting from driver_default_config
+// Returns 0 and prints the usage on invalid options
+int driver_parse(DriverConfig *config, int argc, char **argv) {
+
+    static const struct option options[] = {
+        {"min",       required_argument, NULL, 'm'},
+        {"max",       required_argument, NULL, 'M'},
+        {"step",      required_argument, NULL, 's'},
+        {"factor",    required_argument, NULL, 'f'},
+        {"k",         required_argument, NULL, 'k'},
+        {"quantile",  required_argument, NULL, 'q'},
+        {"dist",      required_argument, NULL, 'd'},
+        {"range",     required_argument, NULL, 'r'},
+        {"uniques",   required_argument, NULL, 'u'},
+        {"zipf",      required_argument, NULL, 'z'},
+        {"swaps",     required_argument, NULL, 'w'},
+        {"algos",     required_argument, NULL, 'a'},
+        {"same",      required_argument, NULL, 'S'},
+        {"different", required_argument, NULL, 'D'},
+        {"no-copy",   no_argument,       NULL, 'n'},
+        {"counters",  no_argument,       NULL, 'c'},
+        {"ops",       no_argument,       NULL, 'O'},
+        {"format",    required_argument, NULL, 'F'},
+        {"output",    required_argument, NULL, 'o'},
+        {"seed",      required_argument, NULL, 'x'},
+        {"cores",     required_argument, NULL, 'C'},
+        {"variance",  no_argument,       NULL, 'V'},
+        {"help",      no_argument,       NULL, 'h'},
+        {NULL, 0, NULL, 0}
+    };
+    int outputSet = 0;
+    int kthSet = 0;
+    int option;
+
+    driver_default_config(config);
+    while ((option = getopt_long(argc, argv, "", options, NULL)) != -1) {
+        switch (option) {
+            case 'm': config->minLen = atoll(optarg); break;
+            case 'M': config->maxLen = atoll(optarg); break;
+            case 's': config->step = atoll(optarg); config->factor = 0; break;
+            case 'f': config->factor = atof(optarg); break;
+            case 'k': config->kth = atoll(optarg); kthSet = 1; break;
+            case 'q': config->quantile = atof(optarg); config->kth = 0; kthSet = 0; break;
+            case 'd':
+                if (!gen_parse_distribution(optarg, &config->dist)) {
+                    fprintf(stderr, "Unknown distribution : %s\n", optarg);
+                    return 0;
+                }
+                break;
+            case 'r': config->params.range = atoll(optarg); break;
+            case 'u': config->params.uniques = atoi(optarg); break;
+            case 'z': config->params.zipfExponent = atof(optarg); break;
+            case 'w': config->params.swapPercent = atof(optarg); break;
+            case 'a':
+                if (!driver_parse_algorithms(config, optarg))
+                    return 0;
+                break;
+            case 'S': config->sameTests = atoi(optarg); break;
+            case 'D': config->differentTests = atoi(optarg); break;
+            case 'n': config->copyOverhead = 0; break;
+            case 'c': config->counters = 1; break;
+            case 'O':
+                if (!op_enabled()) {
+                    fprintf(stderr, "--ops needs a build with -DSELECT_COUNT_OPS\n");
+                    return 0;
+                }
+                config->ops = 1;
+                break;
+            case 'F':
+                if (strcmp(optarg, "tsv") == 0) {
+                    config->format = formatTsv;
+                } else if (strcmp(optarg, "csv") == 0) {
+                    config->format = formatCsv;
+                } else if (strcmp(optarg, "json") == 0) {
+                    config->format = formatJson;
+                } else {
+                    fprintf(stderr, "Unknown format : %s\n", optarg);
+                    return 0;
+                }
+                break;
+            case 'o': config->output = optarg; outputSet = 1; break;
+            case 'C':
+                if (!driver_parse_cores(config, optarg)) {
+                    fprintf(stderr, "Invalid core list : %s\n", optarg);
+                    return 0;
+                }
+                break;
+            case 'V': config->variance = 1; break;
+            case 'x': config->seed = strtoull(optarg, NULL, 10); config->seeded = 1; break;
+            default:
+                driver_usage(stderr, argv[0]);
+                return 0;
+        }
+    }
+
+    // csv and json describe a whole run, printed to stdout unless a file is given
+    if (!outputSet && config->format != formatTsv)
+        config->output = "-";
+
+    // parallel_select, radix_select and the generator share one thread pool, which the workers cannot all use
+    for (int i = 0; config->coresLen > 0 && i < config->algorithmsLen; i++) {
+        if (config->algorithms[i]->f == parallel_select || config->algorithms[i]->f == radix_select) {
+            fprintf(stderr, "%s cannot be measured with --cores\n", config->algorithms[i]->name);
+            return 0;
+        }
+    }
+
+    // --k 0 would silently fall back to the quantile, --variance only measures the workers of --cores
+    if (optind < argc || (kthSet && config->kth < 1) || (config->variance && config->coresLen == 0)
+        || config->minLen < 1 || config->maxLen < config->minLen || config->maxLen > INT_MAX
+        || (config->factor == 0 && config->step < 1) || (config->factor != 0 && config->factor <= 1)
+        || config->quantile < 0 || config->quantile > 1 || config->sameTests < 1 || config->differentTests < 2
+        || config->params.range < 0 || config->params.range > INT_MAX || config->params.uniques < 1
+        || config->params.zipfExponent <= 0 || config->params.swapPercent < 0) {
+        driver_usage(stderr, argv[0]);
+        return 0;
+    }
+    return 1;
+}
+
+// Next length of the progression, always at least one more than the current one
+static long long driver_next_length(DriverConfig *config, long long arrLen, int exponent) {
+
+    if (config->factor == 0)
+        return arrLen + config->step;
+    long long next = (long long)(config->minLen * pow(config->factor, exponent));
+    return next > arrLen ? next : arrLen + 1;
+}
+
+static int driver_kth(DriverConfig *config, int arrLen) {
+
+    long long kth = config->kth > 0 ? config->kth : (long long)(config->quantile * arrLen);
+    if (kth < 1)
+        kth = 1;
+    if (kth > arrLen)
+        kth = arrLen;
+    return (int)kth;
+}
+
+static void driver_seed(DriverConfig *config) {
+
+    if (!config->seeded) {
+        config->seed = gen_random_seed();
+        config->seeded = 1;
+    }
+}
+
+static void driver_cpu_model(char *model, size_t len) {
+
+    char line[256];
+    FILE *fp = fopen("/proc/cpuinfo", "r");
+
+    snprintf(model, len, "unknown");
+    if (fp == NULL)
+        return;
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        if (strncmp(line, "model name", 10) == 0) {
+            char *value = strchr(line, ':');
+            if (value != NULL) {
+                value += strspn(value, ": \t");
+                value[strcspn(value, "\n")] = '\0';
+                snprintf(model, len, "%s", value);
+            }
+            break;
+        }
+    }
+    fclose(fp);
+}
+
+// Prints a JSON string, escaping quotes, backslashes and control characters
+static void driver_json_string(FILE *fp, const char *s) {
+
+    fputc('"', fp);
+    for (; *s != '\0'; s++) {
+        if (*s == '"' || *s == '\\')
+            fprintf(fp, "\\%c", *s);
+        else if ((unsigned char)*s < 0x20)
+            fprintf(fp, "\\u%04x", *s);
+        else
+            fputc(*s, fp);
+    }
+    fputc('"', fp);
+}
+
+// Pins the calling thread to a single core
+// Returns 0 if the core is not available to the process
+static int driver_pin(int core) {
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &set) == 0;
+}
+
+// Writes a cpu mask as a list of cores such as "0,2,4-7"
+static void driver_format_mask(const cpu_set_t *set, char *buf, size_t len) {
+
+    size_t used = 0;
+    buf[0] = '\0';
+    for (int core = 0; core < CPU_SETSIZE && used < len; core++) {
+        if (!CPU_ISSET(core, set))
+            continue;
+        int last = core;
+        while (last + 1 < CPU_SETSIZE && CPU_ISSET(last + 1, set))
+            last++;
+        const char *separator = used > 0 ? "," : "";
+        if (last > core)
+            used += snprintf(buf + used, len - used, "%s%d-%d", separator, core, last);
+        else
+            used += snprintf(buf + used, len - used, "%s%d", separator, core);
+        core = last;
+    }
+}
+
+// In order to decrease the amount of trashing caused by the program switching cores
+// and thus invalidating L1 and L2 cache, the main thread is pinned to a single core :
+// the first one of --cores, else the first one available to the process
+// The shared thread pool is created beforehand, so that its threads keep the whole mask of the
+// process instead of inheriting a single core and being time-sliced on it
+// Describes the masks in use in affinity, as recorded in the output
+static void driver_setup_affinity(DriverConfig *config, char *affinity, size_t len) {
+
+    cpu_set_t process, workers;
+    char processList[128], workersList[128];
+
+    if (sched_getaffinity(0, sizeof(cpu_set_t), &process) != 0) {
+        CPU_ZERO(&process);
+        CPU_SET(0, &process);
+    }
+    driver_format_mask(&process, processList, sizeof(processList));
+    parallel_pool();
+
+    int core = 0;
+    if (config->coresLen > 0) {
+        core = config->cores[0];
+    } else {
+        while (core < CPU_SETSIZE - 1 && !CPU_ISSET(core, &process))
+            core++;
+    }
+    int pinned = driver_pin(core);
+
+    if (config->coresLen > 0) {
+        CPU_ZERO(&workers);
+        for (int w = 0; w < config->coresLen; w++) {
+            CPU_SET(config->cores[w], &workers);
+        }
+        driver_format_mask(&workers, workersList, sizeof(workersList));
+        snprintf(affinity, len, "workers on cpus %s, generator pool of %d threads on cpus %s",
+                 workersList, parallel_get_threads(), processList);
+    } else if (pinned) {
+        snprintf(affinity, len, "main thread on cpu %d, pool of %d threads on cpus %s",
+                 core, parallel_get_threads(), processList);
+    } else {
+        snprintf(affinity, len, "main thread and pool of %d threads on cpus %s",
+                 parallel_get_threads(), processList);
+    }
+}
+
+// Metadata : comment lines for csv, a "meta" object for json, a single comment line for tsv
+static void driver_print_header(DriverConfig *config, FILE *fp, const char *affinity) {
+
+    char cpu[256];
+    char date[64];
+    time_t now = time(NULL);
+
+    driver_cpu_model(cpu, sizeof(cpu));
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+
+    const char *dist = gen_distribution_name(config->dist);
+    GenParams *params = &config->params;
+
+    if (config->format == formatTsv) {
+        fprintf(fp, "# seed : %llu\tdist : %s\trange : %lld\tuniques : %d\tzipf : %g\tswaps : %g\taffinity : %s\n",
+                (unsigned long long)config->seed, dist, params->range, params->uniques,
+                params->zipfExponent, params->swapPercent, affinity);
+    } else if (config->format == formatCsv) {
+        fprintf(fp, "# cpu : %s\n# compiler : %s\n# cflags : %s\n# date : %s\n# seed : %llu\n"
+                    "# dist : %s\n# range : %lld\n# uniques : %d\n# zipf : %g\n# swaps : %g\n"
+                    "# same_tests : %d\n# different_tests : %d\n# affinity : %s\n",
+                cpu, DRIVER_COMPILER, SELECT_CFLAGS, date, (unsigned long long)config->seed,
+                dist, params->range, params->uniques, params->zipfExponent, params->swapPercent,
+                config->sameTests, config->differentTests, affinity);
+        fprintf(fp, "n,k");
+        for (int i = 0; i < config->algorithmsLen; i++) {
+            fprintf(fp, ",%s_mean,%s_stddev", config->algorithms[i]->name, config->algorithms[i]->name);
+            for (int j = 0; config->counters && j < PERF_COUNTERS; j++) {
+                fprintf(fp, ",%s_%s", config->algorithms[i]->name, perf_counter_name((enum perfCounter)j));
+            }
+            for (int j = 0; config->ops && j < DRIVER_OPS; j++) {
+                fprintf(fp, ",%s_%s", config->algorithms[i]->name, driverOpNames[j]);
+            }
+        }
+        if (config->copyOverhead)
+            fprintf(fp, ",copy,scratch");
+        fprintf(fp, "\n");
+    } else if (config->format == formatJson) {
+        fprintf(fp, "{\n  \"meta\": {\"cpu\": ");
+        driver_json_string(fp, cpu);
+        fprintf(fp, ", \"compiler\": ");
+        driver_json_string(fp, DRIVER_COMPILER);
+        fprintf(fp, ", \"cflags\": ");
+        driver_json_string(fp, SELECT_CFLAGS);
+        fprintf(fp, ", \"date\": \"%s\", \"seed\": %llu, \"dist\": \"%s\", \"range\": %lld, \"uniques\": %d,"
+                    " \"zipf\": %g, \"swaps\": %g, \"same_tests\": %d, \"different_tests\": %d, \"affinity\": ",
+                date, (unsigned long long)config->seed, dist, params->range, params->uniques,
+                params->zipfExponent, params->swapPercent, config->sameTests, config->differentTests);
+        driver_json_string(fp, affinity);
+        fprintf(fp, "},\n  \"results\": [");
+    }
+}
+
+// Prints a counter per element; unavailable counters are NAN, written as nan (null in json)
+static void driver_print_counter(DriverConfig *config, FILE *fp, const char *separator, double value) {
+
+    if (isnan(value))
+        fprintf(fp, "%s%s", separator, config->format == formatJson ? "null" : "nan");
+    else
+        fprintf(fp, "%s%0.4lf", separator, value);
+}
+
+// means and deviations hold one value per algorithm, followed by the two copy overheads
+// counters holds the hardware counters per element of each algorithm, printed with --counters
+// ops holds the operation counts of each algorithm, printed with --ops : comparisons, swaps and
+// sift steps per element, partition passes and the deepest recursion per call
+static void driver_print_row(DriverConfig *config, FILE *fp, int row, int arrLen, int kth,
+                             double *means, double *deviations, double (*counters)[PERF_COUNTERS],
+                             double (*ops)[DRIVER_OPS]) {
+
+    int count = config->algorithmsLen;
+
+    if (config->format == formatTsv || config->format == formatCsv) {
+        const char *separator = config->format == formatTsv ? "\t" : ",";
+        fprintf(fp, "%d%s%d", arrLen, separator, kth);
+        for (int i = 0; i < count; i++) {
+            fprintf(fp, "%s%0.9lf%s%0.9lf", separator, means[i], separator, deviations[i]);
+            for (int j = 0; config->counters && j < PERF_COUNTERS; j++) {
+                driver_print_counter(config, fp, separator, counters[i][j]);
+            }
+            for (int j = 0; config->ops && j < DRIVER_OPS; j++) {
+                fprintf(fp, "%s%0.4lf", separator, ops[i][j]);
+            }
+        }
+        if (config->copyOverhead)
+            fprintf(fp, "%s%0.9lf%s%0.9lf", separator, means[count], separator, means[count + 1]);
+        fprintf(fp, "\n");
+    } else {
+        fprintf(fp, "%s\n    {\"n\": %d, \"k\": %d", row > 0 ? "," : "", arrLen, kth);
+        for (int i = 0; i < count; i++) {
+            fprintf(fp, ", \"%s\": {\"mean\": %0.9lf, \"stddev\": %0.9lf",
+                    config->algorithms[i]->name, means[i], deviations[i]);
+            for (int j = 0; config->counters && j < PERF_COUNTERS; j++) {
+                fprintf(fp, ", \"%s\": ", perf_counter_name((enum perfCounter)j));
+                driver_print_counter(config, fp, "", counters[i][j]);
+            }
+            for (int j = 0; config->ops && j < DRIVER_OPS; j++) {
+                fprintf(fp, ", \"%s\": %0.4lf", driverOpNames[j], ops[i][j]);
+            }
+            fprintf(fp, "}");
+        }
+        if (config->copyOverhead)
+            fprintf(fp, ", \"copy\": %0.9lf, \"scratch\": %0.9lf", means[count], means[count + 1]);
+        fprintf(fp, "}");
+    }
+    fflush(fp);
+}
+
+static void driver_print_screen(DriverConfig *config, int arrLen, int kth, double *means, double *deviations,
+                                double (*counters)[PERF_COUNTERS], double (*ops)[DRIVER_OPS]) {
+
+    int count = config->algorithmsLen;
+
+    printf("N : %d\tK : %d", arrLen, kth);
+    for (int i = 0; i < count; i++) {
+        printf("\t%s : %0.9lf\tD : %0.9lf", config->algorithms[i]->name, means[i], deviations[i]);
+        for (int j = 0; config->counters && j < PERF_COUNTERS; j++) {
+            if (!isnan(counters[i][j]))
+                printf("\t%s/n : %0.4lf", perf_counter_name((enum perfCounter)j), counters[i][j]);
+        }
+        if (config->ops)
+            printf("\tcmp/n : %0.2lf\tswp/n : %0.2lf\tpasses : %0.1lf\tsift/n : %0.2lf\tdepth : %0.0lf",
+                   ops[i][0], ops[i][1], ops[i][2], ops[i][3], ops[i][4]);
+    }
+    if (config->copyOverhead)
+        printf("\tC1 : %0.9lf\tC2 : %0.9lf", means[count], means[count + 1]);
+    printf("\n");
+}
+
+// Measurements taken on one array
+struct _driverTrial {
+    double timings[DRIVER_MAX_ALGORITHMS + 2];              // per algorithm, then the two copy overheads
+    double counters[DRIVER_MAX_ALGORITHMS][PERF_COUNTERS];  // summed over the sameTests calls
+    OpCounters ops[DRIVER_MAX_ALGORITHMS];
+    int core;                                               // core of the worker, -1 when run serially
+};
+
+// Generates the array of a trial from its seed and measures every algorithm on it
+// Serial runs fill the array on the shared thread pool, workers fill their own buffer themselves
+static void driver_trial(DriverConfig *config, int *arr, int n, int kth, uint64_t seed, int serial,
+                         struct _driverTrial *t) {
+
+    int count = config->algorithmsLen;
+    double lastCounters[PERF_COUNTERS];
+
+    // Creates an array of the chosen distribution from its own seed
+    if (serial)
+        gen_fill(arr, n, config->dist, &config->params, seed);
+    else
+        gen_fill_serial(arr, n, config->dist, &config->params, seed);
+
+    // Multiple tests are performed in order to reduce jitter caused by the system as much as possible
+    // Assumes the size of the array and its values are not modified between tests
+    memset(t, 0, sizeof(struct _driverTrial));
+    for (int j = 0; j < config->sameTests; j++) {
+        for (int c = 0; c < count; c++) {
+            t->timings[c] += compute_selection_timings(config->algorithms[c]->f, arr, n, kth);
+            if (config->counters) {
+                compute_last_counters(lastCounters);
+                for (int e = 0; e < PERF_COUNTERS; e++) {
+                    t->counters[c][e] += lastCounters[e];
+                }
+            }
+        }
+        // Copy overhead discarded by compute_selection_timings:
+        // malloc + memcpy + free for quick_select, memcpy alone into a reused scratch buffer
+        if (config->copyOverhead) {
+            t->timings[count] += compute_copy_timings(quick_select, arr, n, kth);
+            t->timings[count + 1] += compute_copy_timings(time_quick_scratch, arr, n, kth);
+        }
+    }
+    for (int c = 0; c < count + 2; c++) {
+        t->timings[c] /= config->sameTests;
+    }
+
+    // Operation counts come from one extra, untimed call per array
+    for (int c = 0; config->ops && c < count; c++) {
+        op_reset();
+        config->algorithms[c]->f(arr, n, kth, 0);
+        op_read(&t->ops[c]);
+    }
+    t->core = -1;
+}
+
+/*
+ * ===============================================
+ *      Parallel runner : one worker per core
+ * ===============================================
+ */
+
+// State shared by the workers of one array length
+struct _driverWorkers {
+    DriverConfig *config;
+    int n;
+    int kth;
+    const uint64_t *seeds;          // seed of each trial
+    struct _driverTrial *trials;    // results, indexed by trial
+    int next;                       // next trial to run, taken atomically
+};
+
+struct _driverWorker {
+    struct _driverWorkers *shared;
+    int core;
+    pthread_t thread;
+};
+
+// Runs trials until none is left, each in its own buffer
+// Trials are taken in order but by whichever worker is free; results land at the trial's index,
+// so that merging them does not depend on the scheduling
+static void *driver_worker(void *arg) {
+
+    struct _driverWorker *worker = arg;
+    struct _driverWorkers *shared = worker->shared;
+    DriverConfig *config = shared->config;
+    int *arr = malloc((size_t)shared->n * sizeof(int));
+    int i;
+
+    if (!driver_pin(worker->core))
+        fprintf(stderr, "Cannot pin a worker to core %d\n", worker->core);
+    // Counters only count the thread that opens them
+    if (config->counters)
+        compute_enable_counters(1);
+
+    while ((i = __atomic_fetch_add(&shared->next, 1, __ATOMIC_RELAXED)) < config->differentTests) {
+        driver_trial(config, arr, shared->n, shared->kth, shared->seeds[i], 0, &shared->trials[i]);
+        shared->trials[i].core = worker->core;
+    }
+
+    // The scratch buffer, heap arena and counters of this thread would otherwise outlive it
+    compute_release();
+    heap_pool_release();
+    free(arr);
+    return NULL;
+}
+
+static void driver_run_workers(DriverConfig *config, int n, int kth, const uint64_t *seeds,
+                               struct _driverTrial *trials) {
+
+    struct _driverWorkers shared = {config, n, kth, seeds, trials, 0};
+    struct _driverWorker *workers = malloc(config->coresLen * sizeof(struct _driverWorker));
+
+    for (int w = 0; w < config->coresLen; w++) {
+        workers[w].shared = &shared;
+        workers[w].core = config->cores[w];
+        pthread_create(&workers[w].thread, NULL, driver_worker, &workers[w]);
+    }
+    for (int w = 0; w < config->coresLen; w++) {
+        pthread_join(workers[w].thread, NULL);
+    }
+    free(workers);
+}
+
+// Cross-core variance of one array length, printed on stderr
+// Spread : (slowest - fastest) per-core mean time of each algorithm, relative to the overall mean
+// Skew : the first trials are run again on the first core with every other worker idle;
+// mean parallel time / mean serial time - 1 on those same arrays
+static void driver_report_variance(DriverConfig *config, int n, int kth, const uint64_t *seeds,
+                                   struct _driverTrial *trials) {
+
+    int count = config->algorithmsLen;
+    int checks = config->differentTests < DRIVER_VARIANCE_CHECKS ? config->differentTests : DRIVER_VARIANCE_CHECKS;
+    int *arr = malloc((size_t)n * sizeof(int));
+    double serial[DRIVER_MAX_ALGORITHMS] = {0};
+    double parallel[DRIVER_MAX_ALGORITHMS] = {0};
+    struct _driverTrial t;
+    cpu_set_t affinity;
+
+    // The serial re-runs are pinned like the workers, then the thread gets its affinity back
+    int restore = pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &affinity) == 0;
+    driver_pin(config->cores[0]);
+    for (int i = 0; i < checks; i++) {
+        driver_trial(config, arr, n, kth, seeds[i], 1, &t);
+        for (int c = 0; c < count; c++) {
+            serial[c] += t.timings[c];
+            parallel[c] += trials[i].timings[c];
+        }
+    }
+    if (restore)
+        pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &affinity);
+    free(arr);
+
+    fprintf(stderr, "Variance N : %d", n);
+    for (int c = 0; c < count; c++) {
+        double fastest = INFINITY, slowest = 0, overall = 0;
+        for (int w = 0; w < config->coresLen; w++) {
+            double sum = 0;
+            int runs = 0;
+            for (int i = 0; i < config->differentTests; i++) {
+                if (trials[i].core == config->cores[w]) {
+                    sum += trials[i].timings[c];
+                    runs++;
+                }
+            }
+            if (runs > 0) {
+                fastest = fmin(fastest, sum / runs);
+                slowest = fmax(slowest, sum / runs);
+            }
+            overall += sum;
+        }
+        overall /= config->differentTests;
+        double spread = overall > 0 ? 100 * (slowest - fastest) / overall : 0;
+        double skew = serial[c] > 0 ? 100 * (parallel[c] / serial[c] - 1) : 0;
+        fprintf(stderr, "\t%s : spread %0.1lf%% skew %+0.1lf%%%s", config->algorithms[c]->name, spread, skew,
+                (fabs(skew) > DRIVER_SKEW_WARNING || spread > DRIVER_SKEW_WARNING) ? " (!)" : "");
+    }
+    fprintf(stderr, "\n");
+}
+
+// Runs the progression described by the configuration
+// For every length, differentTests arrays are generated and each algorithm is timed sameTests
+// times on each of them; the mean over the arrays and its standard deviation are reported
+// With cores, the arrays are spread over one pinned worker per core
+void driver_run(DriverConfig *config) {
+
+    int count = config->algorithmsLen;
+    int columns = count + 2;
+    int differentTests = config->differentTests;
+    // timings[c * differentTests + i] : mean time of column c on the ith array
+    double *timings = malloc((size_t)columns * differentTests * sizeof(double));
+    double means[DRIVER_MAX_ALGORITHMS + 2];
+    double deviations[DRIVER_MAX_ALGORITHMS + 2];
+    // Hardware counters of each algorithm, summed over all calls then divided by calls * n
+    double counters[DRIVER_MAX_ALGORITHMS][PERF_COUNTERS];
+    double ops[DRIVER_MAX_ALGORITHMS][DRIVER_OPS];
+    struct _driverTrial *trials = malloc(differentTests * sizeof(struct _driverTrial));
+    uint64_t *trialSeeds = malloc(differentTests * sizeof(uint64_t));
+    int toStdout = strcmp(config->output, "-") == 0;
+    FILE *fp = NULL;
+    char affinity[320];
+
+    driver_seed(config);
+    driver_setup_affinity(config, affinity, sizeof(affinity));
+    if (config->counters)
+        compute_enable_counters(1);
+    // Workers would otherwise all compute the resolution at once
+    compute_prepare();
+
+    if (toStdout) {
+        fp = stdout;
+    } else {
+        // tsv keeps appending to the same file, the other formats start a new one
+        fp = fopen(config->output, config->format == formatTsv ? "a" : "w");
+        if (fp == NULL)
+            exit(EXIT_FAILURE);
+    }
+    driver_print_header(config, fp, affinity);
+    if (config->format == formatTsv && !toStdout) {
+        fclose(fp);
+        fp = NULL;
+    }
+    if (!toStdout)
+        printf("Seed : %llu\nAffinity : %s\n", (unsigned long long)config->seed, affinity);
+
+    GenRng seeds;
+    gen_seed(&seeds, config->seed);
+
+    int exponent = 0;
+    int row = 0;
+    long long arrLen = config->minLen;
+
+    // Used to create multiple tests following a specific progression of values
+    while (arrLen <= config->maxLen) {
+
+        int n = (int)arrLen;
+        int kth = driver_kth(config, n);
+
+        // Multiple tests are performed in order to create a monotonic function from the computed results
+        // Assumes the size of the array is not modified between tests, but its values are
+        // Seeds are drawn up front, so that each array is the same whichever worker builds it
+        for (int i = 0; i < differentTests; i++) {
+            trialSeeds[i] = gen_next(&seeds);
+        }
+        if (config->coresLen > 0) {
+            driver_run_workers(config, n, kth, trialSeeds, trials);
+            if (config->variance)
+                driver_report_variance(config, n, kth, trialSeeds, trials);
+        } else {
+            int *arr = malloc((size_t)n * sizeof(int));
+            for (int i = 0; i < differentTests; i++) {
+                driver_trial(config, arr, n, kth, trialSeeds[i], 1, &trials[i]);
+            }
+            free(arr);
+        }
+
+        // Merged in trial order
+        memset(counters, 0, sizeof(counters));
+        memset(ops, 0, sizeof(ops));
+        for (int i = 0; i < differentTests; i++) {
+            for (int c = 0; c < columns; c++) {
+                timings[c * differentTests + i] = trials[i].timings[c];
+            }
+            for (int c = 0; c < count; c++) {
+                OpCounters *o = &trials[i].ops[c];
+                for (int e = 0; e < PERF_COUNTERS; e++) {
+                    counters[c][e] += trials[i].counters[c][e];
+                }
+                ops[c][0] += (double)o->comparisons / n;
+                ops[c][1] += (double)o->swaps / n;
+                ops[c][2] += (double)o->passes;
+                ops[c][3] += (double)o->siftSteps / n;
+                if (o->maxDepth > ops[c][4])
+                    ops[c][4] = o->maxDepth;
+            }
+        }
+
+        for (int c = 0; c < count; c++) {
+            for (int e = 0; e < PERF_COUNTERS; e++) {
+                counters[c][e] /= (double)config->sameTests * differentTests * n;
+            }
+            // Averages over the arrays, except the depth which is the deepest seen
+            for (int e = 0; e < DRIVER_OPS - 1; e++) {
+                ops[c][e] /= differentTests;
+            }
+        }
+        for (int c = 0; c < columns; c++) {
+            compute_standardDeviation(timings + c * differentTests, differentTests);
+            means[c] = timings[c * differentTests];
+            deviations[c] = timings[c * differentTests + 1];
+        }
+
+        if (config->format == formatTsv && !toStdout) {
+            // Appended line by line, so that an interrupted run keeps its results
+            fp = fopen(config->output, "a");
+            if (fp == NULL)
+                exit(EXIT_FAILURE);
+            driver_print_row(config, fp, row, n, kth, means, deviations, counters, ops);
+            fclose(fp);
+            fp = NULL;
+        } else {
+            driver_print_row(config, fp, row, n, kth, means, deviations, counters, ops);
+        }
+        if (!toStdout)
+            driver_print_screen(config, n, kth, means, deviations, counters, ops);
+
+        // while cycle's guard
+        row++;
+        exponent++;
+        arrLen = driver_next_length(config, arrLen, exponent);
+    }
+
+    if (config->format == formatJson)
+        fprintf(fp, "\n  ]\n}\n");
+    if (fp != NULL && !toStdout)
+        fclose(fp);
+    free(trials);
+    free(trialSeeds);
+    free(timings);
+}
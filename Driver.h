@@ -0,0 +1,59 @@
+#ifndef DRIVER_H
+#define DRIVER_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Time.h"
+#include "PartitionKernels.h"
+#include "ParallelSelect.h"
+#include "DaryHeap.h"
+#include "Generator.h"
+#include "RadixSelect.h"
+
+// Compiler flags recorded in the metadata, e.g. gcc -DSELECT_CFLAGS="\"-O2 -march=native\"" ...
+#ifndef SELECT_CFLAGS
+#define SELECT_CFLAGS "unknown"
+#endif
+
+#define DRIVER_MAX_ALGORITHMS 16
+#define DRIVER_MAX_CORES 256
+
+enum driverFormat {formatTsv, formatCsv, formatJson};
+
+struct _driverAlgorithm {
+    const char *name;
+    int (*f)(int *, int, int, int);
+}; typedef struct _driverAlgorithm DriverAlgorithm;
+
+struct _driverConfig {
+    long long minLen;
+    long long maxLen;
+    long long step;         // linear progression when factor is 0
+    double factor;          // geometric progression when greater than 1
+    long long kth;          // absolute rank, 0 to use quantile
+    double quantile;
+    enum genDistribution dist;
+    GenParams params;       // params.range 0 draws values in [-n/2, n/2]
+    int sameTests;
+    int differentTests;
+    int copyOverhead;       // also reports the copy overhead of quick_select
+    int counters;           // also reports hardware counters per element, when available
+    int ops;                // also reports operation counts, needs -DSELECT_COUNT_OPS
+    const DriverAlgorithm *algorithms[DRIVER_MAX_ALGORITHMS];
+    int algorithmsLen;
+    enum driverFormat format;
+    const char *output;     // "-" for stdout
+    int cores[DRIVER_MAX_CORES]; // cores of the parallel runner, none to run serially
+    int coresLen;
+    int variance;           // reports the cross-core variance of the parallel runner
+    uint64_t seed;          // each array is generated from its own seed, drawn from this one
+    int seeded;
+}; typedef struct _driverConfig DriverConfig;
+
+void driver_default_config(DriverConfig *);
+int  driver_parse(DriverConfig *, int, char **);
+void driver_usage(FILE *, const char *);
+void driver_run(DriverConfig *);
+
+#endif // DRIVER_H
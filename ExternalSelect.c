@@ -0,0 +1,273 @@
+/*
+ * ===============================================
+ *    Implementation of External Memory Select
+ * ===============================================
+ */
+
+#include "ExternalSelect.h"
+#include "ColumnFile.h"
+#include <limits.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/resource.h>
+
+// Number of values sampled to choose the pivots of a pass
+#define EXTERNAL_SAMPLE 4096
+// Width of the pivot band around the expected rank, in values of the sorted sample
+#define EXTERNAL_BAND 96
+// Values scanned between two madvise calls releasing the pages already read
+#define EXTERNAL_CHUNK (1 << 22)
+
+static int external_compare(const void *a, const void *b) {
+
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+static unsigned long long external_random(unsigned long long *state) {
+
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+static void external_count_pass(ExternalStats *stats, long long bytes) {
+
+    if (stats->passes < EXTERNAL_MAX_PASSES)
+        stats->bytesRead[stats->passes] = bytes;
+    stats->passes++;
+}
+
+// Tells the kernel the pages of [begin, end) have been read and can be dropped from the process
+static void external_release(const int *data, long long begin, long long end) {
+
+    long page = sysconf(_SC_PAGESIZE);
+    uintptr_t first = ((uintptr_t)(data + begin) + page - 1) / page * page;
+    uintptr_t last = (uintptr_t)(data + end) / page * page;
+    if (last > first)
+        madvise((void *)first, last - first, MADV_DONTNEED);
+}
+
+// Finds the kth smallest of the n values of "data" (typically a read-only mapping of a file)
+// holding at most "budget" values in memory
+// Each pass streams through the data once : it counts the values of the current band (values in
+// [bandLo, bandHi]) that fall below, inside and above two pivots taken from a sample of the band,
+// and keeps a reservoir sample of each of the three sub-bands for the next pass
+// Once the sub-band holding k fits the budget, it is gathered into memory and finished by intro_rec
+// A precomputed sample (such as the one stored in a column file) replaces the first sampling pass
+// Pages already read are dropped from the process when "release" is set, which is only valid
+// for a file mapping (an anonymous mapping would lose its content)
+// Returns 1 and sets *result on success
+static int external_select_range(const int *data, long long n, long long kth, long long budget,
+                                 const int *stored, int storedLen, ExternalStats *stats, int *result,
+                                 int release) {
+
+    if (kth < 1 || kth > n)
+        return 0;
+    // The final band is indexed with ints by intro_rec
+    if (budget > INT_MAX)
+        budget = INT_MAX;
+    if (budget < EXTERNAL_SAMPLE)
+        budget = EXTERNAL_SAMPLE;
+
+    int *sample = malloc(EXTERNAL_SAMPLE * sizeof(int));
+    int *reservoirs = malloc(3 * EXTERNAL_SAMPLE * sizeof(int));
+    int sampleLen = EXTERNAL_SAMPLE;
+    unsigned long long state = 0x9E3779B97F4A7C15ULL;
+    long long bandLen = n;
+    int bandLo = INT_MIN, bandHi = INT_MAX;
+    long long k = kth;
+    int found = 0;
+
+    stats->passes = 0;
+    stats->gathered = 0;
+
+    if (storedLen > 0) {
+        // Evenly spaced values of the stored sample, which needs no pass over the data
+        if (storedLen < sampleLen)
+            sampleLen = storedLen;
+        for (int i = 0; i < sampleLen; i++) {
+            sample[i] = stored[(long long)i * storedLen / sampleLen];
+        }
+    } else {
+        // First sample : one random position in each of sampleLen equal strata, read in file order
+        // Fault-around maps the cached neighbours of every sampled page, so pages are released
+        // as the sample moves forward as well
+        if (n < sampleLen)
+            sampleLen = (int)n;
+        long long released = 0;
+        for (int i = 0; i < sampleLen; i++) {
+            long long begin = (long long)i * n / sampleLen;
+            long long width = (long long)(i + 1) * n / sampleLen - begin;
+            long long position = begin + (long long)(external_random(&state) % (unsigned long long)width);
+            sample[i] = data[position];
+            if (release && position - released >= EXTERNAL_CHUNK) {
+                external_release(data, released, position);
+                released = position;
+            }
+        }
+        if (release)
+            external_release(data, released, n);
+        external_count_pass(stats, (long long)sampleLen * sizeof(int));
+    }
+
+    while (!found && bandLen > budget) {
+
+        qsort(sample, sampleLen, sizeof(int), external_compare);
+        long long expected = (long long)((double)k / bandLen * sampleLen);
+        long long loIndex = expected - EXTERNAL_BAND;
+        long long hiIndex = expected + EXTERNAL_BAND;
+        if (expected >= sampleLen)
+            expected = sampleLen - 1;
+        if (loIndex < 0)
+            loIndex = 0;
+        if (hiIndex >= sampleLen)
+            hiIndex = sampleLen - 1;
+        int lo = sample[loIndex];
+        int hi = sample[hiIndex];
+
+        long long counts[3] = {0, 0, 0};
+        for (long long begin = 0; begin < n; begin += EXTERNAL_CHUNK) {
+            long long end = begin + EXTERNAL_CHUNK < n ? begin + EXTERNAL_CHUNK : n;
+            for (long long i = begin; i < end; i++) {
+                int value = data[i];
+                if (value < bandLo || value > bandHi)
+                    continue;
+                int band = (value < lo) ? 0 : ((value > hi) ? 2 : 1);
+                long long seen = counts[band]++;
+                // Reservoir sampling of each sub-band
+                if (seen < EXTERNAL_SAMPLE) {
+                    reservoirs[band * EXTERNAL_SAMPLE + seen] = value;
+                } else {
+                    unsigned long long slot = external_random(&state) % (unsigned long long)(seen + 1);
+                    if (slot < EXTERNAL_SAMPLE)
+                        reservoirs[band * EXTERNAL_SAMPLE + slot] = value;
+                }
+            }
+            if (release)
+                external_release(data, begin, end);
+        }
+        external_count_pass(stats, n * (long long)sizeof(int));
+
+        int band;
+        if (k <= counts[0]) {
+            band = 0;
+            bandHi = lo - 1;
+        } else if (k > counts[0] + counts[1]) {
+            band = 2;
+            k -= counts[0] + counts[1];
+            bandLo = hi + 1;
+        } else {
+            band = 1;
+            k -= counts[0];
+            bandLo = lo;
+            bandHi = hi;
+            if (lo == hi) {
+                *result = lo;
+                found = 1;
+            }
+        }
+
+        // Few distinct values can leave every value of the band between the pivots :
+        // the next pass then uses a single pivot (lo = hi), which always makes progress
+        if (!found && counts[band] == bandLen) {
+            sample[0] = sample[expected];
+            sampleLen = 1;
+            continue;
+        }
+
+        bandLen = counts[band];
+        sampleLen = bandLen < EXTERNAL_SAMPLE ? (int)bandLen : EXTERNAL_SAMPLE;
+        memcpy(sample, reservoirs + band * EXTERNAL_SAMPLE, sampleLen * sizeof(int));
+    }
+
+    if (!found) {
+        // Gathers the surviving band into memory
+        int *band = malloc((bandLen > 0 ? bandLen : 1) * sizeof(int));
+        long long count = 0;
+        for (long long begin = 0; begin < n; begin += EXTERNAL_CHUNK) {
+            long long end = begin + EXTERNAL_CHUNK < n ? begin + EXTERNAL_CHUNK : n;
+            for (long long i = begin; i < end; i++) {
+                int value = data[i];
+                if (value >= bandLo && value <= bandHi)
+                    band[count++] = value;
+            }
+            if (release)
+                external_release(data, begin, end);
+        }
+        external_count_pass(stats, n * (long long)sizeof(int));
+        stats->gathered = count;
+
+        *result = intro_rec(band, 0, (int)count - 1, (int)k);
+        found = 1;
+        free(band);
+    }
+
+    free(sample);
+    free(reservoirs);
+    return found;
+}
+
+// Selects the kth smallest of n values already in memory, as external_select_file does for a file
+int external_select_mapped(const int *data, long long n, long long kth, long long budget,
+                           ExternalStats *stats, int *result) {
+
+    return external_select_range(data, n, kth, budget, NULL, 0, stats, result, 0);
+}
+
+// Maps a binary file and selects its kth smallest value
+// The file is either an int32 column file, whose stored sample gives the first pivots,
+// or a raw array of native-endian ints
+// Returns 1 and sets *result on success, 0 if the file cannot be read or k is out of range
+int external_select_file(const char *path, long long kth, long long budget, ExternalStats *stats, int *result) {
+
+    ColumnFile cf;
+    if (column_open(path, &cf)) {
+        int found = 0;
+        if (cf.header.type == columnInt32) {
+            found = external_select_range(cf.data, (long long)cf.header.count, kth, budget, cf.sample,
+                                          (int)cf.header.sampleLen, stats, result, 1);
+        }
+        column_close(&cf);
+        return found;
+    }
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return 0;
+
+    struct stat st;
+    if (fstat(fd, &st) < 0 || st.st_size < (off_t)sizeof(int)) {
+        close(fd);
+        return 0;
+    }
+
+    long long n = st.st_size / sizeof(int);
+    const int *data = mmap(NULL, n * sizeof(int), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        return 0;
+    madvise((void *)data, n * sizeof(int), MADV_SEQUENTIAL);
+
+    int found = external_select_range(data, n, kth, budget, NULL, 0, stats, result, 1);
+
+    munmap((void *)data, n * sizeof(int));
+    return found;
+}
+
+void external_print_stats(ExternalStats *stats) {
+
+    for (int i = 0; i < stats->passes && i < EXTERNAL_MAX_PASSES; i++) {
+        fprintf(stderr, "Pass %d : %lld bytes read\n", i, stats->bytesRead[i]);
+    }
+    fprintf(stderr, "Gathered : %lld values\n", stats->gathered);
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    fprintf(stderr, "Peak RSS : %ld KB\n", usage.ru_maxrss);
+}
@@ -0,0 +1,21 @@
+#ifndef EXTERNAL_SELECT_H
+#define EXTERNAL_SELECT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "IntroSelect.h"
+
+#define EXTERNAL_MAX_PASSES 64
+
+struct _externalStats {
+    int passes;
+    long long bytesRead[EXTERNAL_MAX_PASSES];   // bytes of the file read by each pass
+    long long gathered;                         // values copied to memory for the final selection
+}; typedef struct _externalStats ExternalStats;
+
+int  external_select_mapped(const int *, long long, long long, long long, ExternalStats *, int *);
+int  external_select_file(const char *, long long, long long, ExternalStats *, int *);
+void external_print_stats(ExternalStats *);
+
+#endif // EXTERNAL_SELECT_H
@@ -0,0 +1,93 @@
+/*
+ * ===============================================
+ * 	 Implementation of Floyd-Rivest Select
+ * ===============================================
+ */
+
+#include "FloydSelect.h"
+
+// Ranges larger than this are first narrowed around k by selecting on a sample
+#define FLOYD_SAMPLE_MIN 600
+// Ranges up to this size are finished with an insertion sort
+#define FLOYD_SMALL 16
+
+void floyd_swap(int *a, int *b) {
+
+    int temp = *a;
+    *a = *b;
+    *b = temp;
+}
+
+// Modifies the array so that arr[k] holds the value it would have if [left, right] were sorted,
+// smaller values on its left and greater ones on its right (k is an index, not a rank)
+// On large ranges, a sample of size ~n^(2/3) around k is selected first (recursively, on a much
+// smaller range) so that the two values bracketing k are almost exact pivots : each pass of the loop
+// then discards all but ~n^(2/3) values, for about n + min(k, n - k) comparisons overall
+// The loop on the main range is iterative
+void floyd_rec(int arr[], int left, int right, int k) {
+
+    while (right > left) {
+
+        if (right - left + 1 <= FLOYD_SMALL) {
+            insertionSort(arr + left, right - left + 1);
+            return;
+        }
+
+        if (right - left > FLOYD_SAMPLE_MIN) {
+            double n = right - left + 1;
+            double i = k - left + 1;
+            double z = log(n);
+            double s = 0.5 * exp(2 * z / 3);
+            double sd = 0.5 * sqrt(z * s * (n - s) / n) * (i - n / 2 < 0 ? -1 : 1);
+            int newLeft = (int)(k - i * s / n + sd);
+            int newRight = (int)(k + (n - i) * s / n + sd);
+            floyd_rec(arr, newLeft > left ? newLeft : left, newRight < right ? newRight : right, k);
+        }
+
+        // Hoare partition of [left, right] around t = arr[k]
+        int t = arr[k];
+        int i = left;
+        int j = right;
+        floyd_swap(&arr[left], &arr[k]);
+        if (arr[right] > t)
+            floyd_swap(&arr[right], &arr[left]);
+        while (i < j) {
+            floyd_swap(&arr[i], &arr[j]);
+            i++;
+            j--;
+            while (arr[i] < t)
+                i++;
+            while (arr[j] > t)
+                j--;
+        }
+        if (arr[left] == t) {
+            floyd_swap(&arr[left], &arr[j]);
+        } else {
+            j++;
+            floyd_swap(&arr[j], &arr[right]);
+        }
+
+        // Keeps the side holding k
+        if (j <= k)
+            left = j + 1;
+        if (k <= j)
+            right = j - 1;
+    }
+}
+
+// Returns the kth smallest value in the given vector
+// Does not modify the vector
+int floyd_select(int *arr, int arrLen, int kth, int mode){
+
+    int result = 0;
+    int *arr_cpy = malloc(arrLen * sizeof(int));
+    memcpy(arr_cpy, (int *)arr, arrLen * sizeof(int));
+
+    if (mode == 0) {
+        floyd_rec(arr_cpy, 0, arrLen - 1, kth - 1);
+        result = arr_cpy[kth - 1];
+    }
+
+    free(arr_cpy);
+    return result;
+}
@@ -0,0 +1,14 @@
+#ifndef FLOYD_SELECT_H
+#define FLOYD_SELECT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "MedianSelect.h"
+
+void floyd_swap(int *, int *);
+void floyd_rec(int *, int, int, int);
+int  floyd_select(int *, int, int, int);
+
+#endif // FLOYD_SELECT_H
@@ -0,0 +1,387 @@
+/*
+ * ===============================================
+ *      Input Generators for the Benchmarks
+ * ===============================================
+ */
+
+#include "Generator.h"
+#include "ParallelSelect.h"
+#include <math.h>
+#include <time.h>
+
+static const char *genNames[distCount] = {"uniform", "sorted", "reverse", "organ-pipe", "few-unique",
+                                          "zipf", "gaussian", "nearly-sorted", "killer"};
+
+static uint64_t gen_splitmix(uint64_t *x) {
+
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static uint64_t gen_rotl(uint64_t x, int k) {
+
+    return (x << k) | (x >> (64 - k));
+}
+
+// Expands the seed with splitmix64, as recommended for xoshiro
+void gen_seed(GenRng *rng, uint64_t seed) {
+
+    for (int i = 0; i < 4; i++) {
+        rng->s[i] = gen_splitmix(&seed);
+    }
+}
+
+uint64_t gen_next(GenRng *rng) {
+
+    uint64_t *s = rng->s;
+    uint64_t result = gen_rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = gen_rotl(s[3], 45);
+    return result;
+}
+
+// Returns a value in [0, bound) with Lemire's multiply-shift, without modulo bias
+uint64_t gen_bounded(GenRng *rng, uint64_t bound) {
+
+    if (bound > 0xFFFFFFFFULL)
+        return gen_next(rng) % bound;
+
+    uint64_t m = (gen_next(rng) >> 32) * bound;
+    uint32_t low = (uint32_t)m;
+    if (low < bound) {
+        uint32_t threshold = (uint32_t)(-(uint32_t)bound) % (uint32_t)bound;
+        while (low < threshold) {
+            m = (gen_next(rng) >> 32) * bound;
+            low = (uint32_t)m;
+        }
+    }
+    return m >> 32;
+}
+
+// Returns a value in [0, 1)
+double gen_double(GenRng *rng) {
+
+    return (gen_next(rng) >> 11) * 0x1.0p-53;
+}
+
+// Seed for runs that do not specify one, read from /dev/urandom
+uint64_t gen_random_seed(void) {
+
+    uint64_t seed = 0;
+    FILE *fp = fopen("/dev/urandom", "rb");
+    if (fp == NULL || fread(&seed, sizeof(seed), 1, fp) != 1)
+        seed = (uint64_t)time(NULL);
+    if (fp != NULL)
+        fclose(fp);
+    return seed;
+}
+
+void gen_default_params(GenParams *params) {
+
+    params->range = 0;
+    params->uniques = 16;
+    params->zipfExponent = 1.0;
+    params->swapPercent = 1.0;
+}
+
+const char *gen_distribution_name(enum genDistribution dist) {
+
+    return (dist >= 0 && dist < distCount) ? genNames[dist] : "unknown";
+}
+
+// Returns 1 and sets *dist if name is one of the distribution names
+int gen_parse_distribution(const char *name, enum genDistribution *dist) {
+
+    for (int i = 0; i < distCount; i++) {
+        if (strcmp(name, genNames[i]) == 0) {
+            *dist = (enum genDistribution)i;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * ===============================================
+ *   Zipf sampling by rejection-inversion
+ *   (Hormann and Derflinger, 1996)
+ * ===============================================
+ */
+
+struct _genZipf {
+    double exponent;
+    double n;
+    double hIntegralX1;
+    double hIntegralN;
+    double s;
+};
+
+static double gen_zipf_helper1(double x) {
+
+    return fabs(x) > 1e-8 ? log1p(x) / x : 1 - x * (0.5 - x * (1.0 / 3 - 0.25 * x));
+}
+
+static double gen_zipf_helper2(double x) {
+
+    return fabs(x) > 1e-8 ? expm1(x) / x : 1 + x * 0.5 * (1 + x / 3 * (1 + 0.25 * x));
+}
+
+static double gen_zipf_h(struct _genZipf *z, double x) {
+
+    return exp(-z->exponent * log(x));
+}
+
+static double gen_zipf_hIntegral(struct _genZipf *z, double x) {
+
+    double logX = log(x);
+    return gen_zipf_helper2((1 - z->exponent) * logX) * logX;
+}
+
+static double gen_zipf_hIntegralInverse(struct _genZipf *z, double x) {
+
+    double t = x * (1 - z->exponent);
+    if (t < -1)
+        t = -1;
+    return exp(gen_zipf_helper1(t) * x);
+}
+
+static void gen_zipf_init(struct _genZipf *z, int n, double exponent) {
+
+    z->exponent = exponent;
+    z->n = n;
+    z->hIntegralX1 = gen_zipf_hIntegral(z, 1.5) - 1;
+    z->hIntegralN = gen_zipf_hIntegral(z, n + 0.5);
+    z->s = 2 - gen_zipf_hIntegralInverse(z, gen_zipf_hIntegral(z, 2.5) - gen_zipf_h(z, 2));
+}
+
+// Returns a rank in [1, n], rank r having probability proportional to 1 / r^exponent
+static int gen_zipf_sample(struct _genZipf *z, GenRng *rng) {
+
+    while (1) {
+        double u = z->hIntegralN + gen_double(rng) * (z->hIntegralX1 - z->hIntegralN);
+        double x = gen_zipf_hIntegralInverse(z, u);
+        double k = floor(x + 0.5);
+        if (k < 1)
+            k = 1;
+        else if (k > z->n)
+            k = z->n;
+        if (k - x <= z->s || u >= gen_zipf_hIntegral(z, k + 0.5) - gen_zipf_h(z, k))
+            return (int)k;
+    }
+}
+
+/*
+ * ===============================================
+ *               Parallel filling
+ * ===============================================
+ */
+
+struct _genFill {
+    int *arr;
+    int n;
+    enum genDistribution dist;
+    long long range;
+    int uniques;
+    double sigma;
+    struct _genZipf zipf;
+    uint64_t seed;
+    int nthreads;
+};
+
+// Value of position i in a ramp going from -range to range over n positions
+static int gen_ramp(struct _genFill *f, long long i, long long n) {
+
+    if (n <= 1)
+        return 0;
+    return (int)(-f->range + (2 * f->range * i) / (n - 1));
+}
+
+// Median-of-3 killer (Musser, 1997) : defeats pivots taken as the median of the first,
+// middle and last values
+// Returns the value of position i, in 1..n before centering
+// The construction pairs i with k + i over the first half, which only stays a permutation
+// when the half k is even : an odd k gives up its last pair, and the leftover largest
+// values (at most 3, including the odd n one) go last in ascending order
+static long long gen_killer_value(long long i, long long n) {
+
+    long long k = n / 2;
+
+    if (k % 2 == 1)
+        k--;
+    if (i >= 2 * k)
+        return i + 1;
+    if (i < k)
+        return (i % 2 == 0) ? i + 1 : k + i;
+    return 2 * (i - k + 1);
+}
+
+// Returns 1 if gen_killer_value is a permutation of 1..n
+static int gen_killer_check(long long n) {
+
+    char *seen = calloc(n + 1, sizeof(char));
+    int valid = seen != NULL;
+
+    for (long long i = 0; valid && i < n; i++) {
+        long long value = gen_killer_value(i, n);
+        valid = value >= 1 && value <= n && !seen[value];
+        if (valid)
+            seen[value] = 1;
+    }
+    free(seen);
+    return valid;
+}
+
+// Killer value of position i, shifted to be centered on 0
+static int gen_killer(long long i, long long n) {
+
+    return (int)(gen_killer_value(i, n) - n / 2);
+}
+
+static void gen_fill_block(struct _genFill *f, long long begin, long long end, GenRng *rng) {
+
+    int *arr = f->arr;
+    long long span = 2 * f->range + 1;
+
+    switch (f->dist) {
+        case distUniform:
+            for (long long i = begin; i < end; i++) {
+                arr[i] = (int)((long long)gen_bounded(rng, span) - f->range);
+            }
+            break;
+        case distSorted:
+        case distNearlySorted:
+            for (long long i = begin; i < end; i++) {
+                arr[i] = gen_ramp(f, i, f->n);
+            }
+            break;
+        case distReverse:
+            for (long long i = begin; i < end; i++) {
+                arr[i] = gen_ramp(f, f->n - 1 - i, f->n);
+            }
+            break;
+        case distOrganPipe:
+            // Ascending first half, descending second half
+            for (long long i = begin; i < end; i++) {
+                long long half = (f->n + 1) / 2;
+                arr[i] = gen_ramp(f, i < half ? i : f->n - 1 - i, half);
+            }
+            break;
+        case distFewUnique:
+            for (long long i = begin; i < end; i++) {
+                arr[i] = (int)gen_bounded(rng, f->uniques) - f->uniques / 2;
+            }
+            break;
+        case distZipf:
+            // Rank 1 is the most frequent value
+            for (long long i = begin; i < end; i++) {
+                arr[i] = gen_zipf_sample(&f->zipf, rng);
+            }
+            break;
+        case distGaussian:
+            // Marsaglia polar method, both values of a pair are used; clamped to [-range, range]
+            for (long long i = begin; i < end; i += 2) {
+                double u, v, s;
+                do {
+                    u = 2 * gen_double(rng) - 1;
+                    v = 2 * gen_double(rng) - 1;
+                    s = u * u + v * v;
+                } while (s >= 1 || s == 0);
+                double scale = f->sigma * sqrt(-2 * log(s) / s);
+                double values[2] = {u * scale, v * scale};
+                for (int j = 0; j < 2 && i + j < end; j++) {
+                    double value = fmax(-(double)f->range, fmin((double)f->range, round(values[j])));
+                    arr[i + j] = (int)value;
+                }
+            }
+            break;
+        case distKiller:
+            for (long long i = begin; i < end; i++) {
+                arr[i] = gen_killer(i, f->n);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+// Thread tid fills blocks tid, tid + nthreads, ... each from its own stream
+static void gen_fill_job(void *ctx, int tid) {
+
+    struct _genFill *f = ctx;
+    long long blocks = ((long long)f->n + GEN_BLOCK - 1) / GEN_BLOCK;
+
+    for (long long b = tid; b < blocks; b += f->nthreads) {
+        GenRng rng;
+        gen_seed(&rng, f->seed ^ (0xD1B54A32D192ED03ULL * (uint64_t)(b + 1)));
+        long long begin = b * GEN_BLOCK;
+        long long end = begin + GEN_BLOCK < f->n ? begin + GEN_BLOCK : f->n;
+        gen_fill_block(f, begin, end, &rng);
+    }
+}
+
+// Fills arr with n values of the given distribution, in parallel on the shared thread pool
+// when "parallel" is set, in the calling thread otherwise
+// The content only depends on (dist, params, n, seed)
+static void gen_fill_with(int *arr, int n, enum genDistribution dist, const GenParams *params, uint64_t seed,
+                          int parallel) {
+
+    struct _genFill f;
+
+    f.arr = arr;
+    f.n = n;
+    f.dist = dist;
+    f.range = params->range > 0 ? params->range : n / 2;
+    f.uniques = params->uniques > 0 ? params->uniques : 1;
+    f.sigma = f.range / 3.0;
+    f.seed = seed;
+    if (dist == distZipf)
+        gen_zipf_init(&f.zipf, f.uniques, params->zipfExponent);
+    if (dist == distKiller && !gen_killer_check(n)) {
+        fprintf(stderr, "The killer sequence of length %d is not a permutation\n", n);
+        exit(EXIT_FAILURE);
+    }
+
+    // Small arrays are filled by the calling thread only
+    if (n <= GEN_BLOCK || !parallel) {
+        f.nthreads = 1;
+        gen_fill_job(&f, 0);
+    } else {
+        ThreadPool *pool = parallel_pool();
+        f.nthreads = pool->nthreads;
+        pool_run(pool, gen_fill_job, &f);
+    }
+
+    if (dist == distNearlySorted && n > 1) {
+        // Swaps at random positions of the whole array, after the parallel fill
+        GenRng rng;
+        long long swaps = (long long)(params->swapPercent / 100.0 * n);
+        gen_seed(&rng, seed);
+        for (long long s = 0; s < swaps; s++) {
+            int a = (int)gen_bounded(&rng, n);
+            int b = (int)gen_bounded(&rng, n);
+            int temp = arr[a];
+            arr[a] = arr[b];
+            arr[b] = temp;
+        }
+    }
+}
+
+void gen_fill(int *arr, int n, enum genDistribution dist, const GenParams *params, uint64_t seed) {
+
+    gen_fill_with(arr, n, dist, params, seed, 1);
+}
+
+// Same output as gen_fill, without the shared thread pool : for callers that are already
+// running on several threads
+void gen_fill_serial(int *arr, int n, enum genDistribution dist, const GenParams *params, uint64_t seed) {
+
+    gen_fill_with(arr, n, dist, params, seed, 0);
+}
@@ -0,0 +1,39 @@
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+// Values written by one generator stream : blocks are independent, so the output only depends
+// on the seed, whatever the number of threads filling the buffer
+#define GEN_BLOCK 65536
+
+enum genDistribution {distUniform, distSorted, distReverse, distOrganPipe, distFewUnique,
+                      distZipf, distGaussian, distNearlySorted, distKiller, distCount};
+
+// xoshiro256** state
+struct _genRng {
+    uint64_t s[4];
+}; typedef struct _genRng GenRng;
+
+struct _genParams {
+    long long range;        // values in [-range, range], 0 for [-n/2, n/2]
+    int uniques;            // distinct values of distFewUnique and distZipf
+    double zipfExponent;    // P(rank r) proportional to 1 / r^zipfExponent
+    double swapPercent;     // random swaps of distNearlySorted, in percent of n
+}; typedef struct _genParams GenParams;
+
+void        gen_seed(GenRng *, uint64_t);
+uint64_t    gen_next(GenRng *);
+uint64_t    gen_bounded(GenRng *, uint64_t);
+double      gen_double(GenRng *);
+uint64_t    gen_random_seed(void);
+void        gen_default_params(GenParams *);
+const char *gen_distribution_name(enum genDistribution);
+int         gen_parse_distribution(const char *, enum genDistribution *);
+void        gen_fill(int *, int, enum genDistribution, const GenParams *, uint64_t);
+void        gen_fill_serial(int *, int, enum genDistribution, const GenParams *, uint64_t);
+
+#endif // GENERATOR_H
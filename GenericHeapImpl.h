@@ -0,0 +1,76 @@
+/*
+ * ===============================================
+ *   Template of the type-specialized heap walk
+ * ===============================================
+ */
+
+// Included once per heap type by GenericSelectImpl.h, after defining:
+// SELECT_HEAP   : suffix of every function (min or max), placed before the type suffix
+// SELECT_BEFORE : "node a must stay above node b", expanded inline in the sift loops
+
+#define SELECT_HEAP_CAT_(a, b) a##_##b
+#define SELECT_HEAP_CAT(a, b)  SELECT_HEAP_CAT_(a, b)
+#define SELECT_HEAP_FN(name)   SELECT_FN(SELECT_HEAP_CAT(name, SELECT_HEAP))
+
+static void SELECT_HEAP_FN(heap_Heapify_up)(SELECT_NODE *data, int index) {
+
+    while (index > 0) {
+        int parent = (index - 1) / 2;
+        if (!SELECT_BEFORE(data[index], data[parent]))
+            break;
+        SELECT_NODE temp = data[parent];
+        data[parent] = data[index];
+        data[index] = temp;
+        index = parent;
+    }
+}
+
+static void SELECT_HEAP_FN(heap_Heapify_down)(SELECT_NODE *data, int size, int index) {
+
+    for (;;) {
+        int left = index * 2 + 1;
+        int right = index * 2 + 2;
+        int best = index;
+
+        if (left < size && SELECT_BEFORE(data[left], data[best]))
+            best = left;
+        if (right < size && SELECT_BEFORE(data[right], data[best]))
+            best = right;
+        if (best == index)
+            break;
+
+        SELECT_NODE temp = data[best];
+        data[best] = data[index];
+        data[index] = temp;
+        index = best;
+    }
+}
+
+// Body of heap_rec for this heap type
+static SELECT_NODE SELECT_HEAP_FN(heap_walk)(SELECT_NODE *hp, int hpSize, SELECT_NODE *aux, int kth) {
+
+    int auxSize = 1;
+
+    for (int i = 0; i <= kth - 2; i++) {
+        int index = aux[0].index;
+        int left = index * 2 + 1;
+        int right = index * 2 + 2;
+
+        aux[0] = aux[--auxSize];
+        SELECT_HEAP_FN(heap_Heapify_down)(aux, auxSize, 0);
+
+        if (left < hpSize) {
+            aux[auxSize] = hp[left];
+            SELECT_HEAP_FN(heap_Heapify_up)(aux, auxSize++);
+        }
+        if (right < hpSize) {
+            aux[auxSize] = hp[right];
+            SELECT_HEAP_FN(heap_Heapify_up)(aux, auxSize++);
+        }
+    }
+    return aux[0];
+}
+
+#undef SELECT_HEAP_CAT_
+#undef SELECT_HEAP_CAT
+#undef SELECT_HEAP_FN
@@ -0,0 +1,43 @@
+/*
+ * ===============================================
+ *   Type-specialized Quick, Median, Heap Select
+ * ===============================================
+ */
+
+// Every element type gets its own copy of GenericSelectImpl.h, so the comparison is expanded
+// inline in each partition and heapify loop instead of going through a function pointer
+// A type added to SELECT_TYPES in GenericSelect.h also needs its block below
+
+#include "GenericSelect.h"
+
+#define SELECT_S    i64
+#define SELECT_T    int64_t
+#define SELECT_LESS SELECT_LESS_NUM
+#include "GenericSelectImpl.h"
+#undef SELECT_S
+#undef SELECT_T
+#undef SELECT_LESS
+
+#define SELECT_S    f32
+#define SELECT_T    float
+#define SELECT_LESS SELECT_LESS_FLT
+#include "GenericSelectImpl.h"
+#undef SELECT_S
+#undef SELECT_T
+#undef SELECT_LESS
+
+#define SELECT_S    f64
+#define SELECT_T    double
+#define SELECT_LESS SELECT_LESS_FLT
+#include "GenericSelectImpl.h"
+#undef SELECT_S
+#undef SELECT_T
+#undef SELECT_LESS
+
+#define SELECT_S    rec
+#define SELECT_T    SelectRecord
+#define SELECT_LESS SELECT_LESS_REC
+#include "GenericSelectImpl.h"
+#undef SELECT_S
+#undef SELECT_T
+#undef SELECT_LESS
@@ -0,0 +1,50 @@
+#ifndef GENERIC_SELECT_H
+#define GENERIC_SELECT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+
+// Record made of a sorting key and an opaque payload that travels with it
+struct _selectRecord {
+    int64_t  key;
+    uint64_t payload;
+}; typedef struct _selectRecord SelectRecord;
+
+// Strict "less than" used by each element type
+// Floating point values follow a total order in which NaN is greater than every number
+// (including +inf) and all NaNs are equal to each other: NaNs are selected last
+#define SELECT_LESS_NUM(a, b) ((a) < (b))
+#define SELECT_LESS_FLT(a, b) ((a) < (b) || (!isnan(a) && isnan(b)))
+#define SELECT_LESS_REC(a, b) ((a).key < (b).key)
+
+// X-macro listing every generated element type : X(suffix, type, less)
+#define SELECT_TYPES(X)                     \
+    X(i64, int64_t,      SELECT_LESS_NUM)   \
+    X(f32, float,        SELECT_LESS_FLT)   \
+    X(f64, double,       SELECT_LESS_FLT)   \
+    X(rec, SelectRecord, SELECT_LESS_REC)
+
+// Typed counterparts of the int engines, e.g. quick_select_f64 or heap_select_rec
+#define SELECT_DECLARE(S, T, LESS)                                  \
+    struct _node_##S {                                              \
+        T   value;                                                  \
+        int index;                                                  \
+    }; typedef struct _node_##S Node_##S;                           \
+                                                                    \
+    void insertionSort_##S(T *, int);                               \
+    int  quick_partition_##S(T *, int, int);                        \
+    T    quick_rec_##S(T *, int, int, int);                         \
+    T    quick_select_##S(T *, int, int, int);                      \
+    int  median_partition_##S(T *, int);                            \
+    void set_median_##S(T *, int);                                  \
+    T    median_rec_##S(T *, int, int);                             \
+    T    median_select_##S(T *, int, int, int);                     \
+    Node_##S heap_rec_##S(Node_##S *, int, Node_##S *, int, int);   \
+    T    heap_select_##S(T *, int, int, int);
+
+SELECT_TYPES(SELECT_DECLARE)
+
+#endif // GENERIC_SELECT_H
@@ -0,0 +1,242 @@
+/*
+ * ===============================================
+ *   Template of the type-specialized selections
+ * ===============================================
+ */
+
+// Included once per element type by GenericSelect.c, after defining:
+// SELECT_S    : suffix appended to every function name
+// SELECT_T    : element type
+// SELECT_LESS : strict "less than" between two SELECT_T values, expanded inline
+// Every function mirrors its int counterpart in QuickSelect.c, MedianSelect.c and HeapSelect.c,
+// the recursions on a single side being turned into loops
+
+#define SELECT_CAT_(a, b) a##_##b
+#define SELECT_CAT(a, b)  SELECT_CAT_(a, b)
+#define SELECT_FN(name)   SELECT_CAT(name, SELECT_S)
+#define SELECT_NODE       SELECT_CAT(Node, SELECT_S)
+
+static void SELECT_FN(select_swap)(SELECT_T *a, SELECT_T *b) {
+
+    SELECT_T temp = *a;
+    *a = *b;
+    *b = temp;
+}
+
+void SELECT_FN(insertionSort)(SELECT_T *arr, int arrLen) {
+
+    for (int i = 1; i < arrLen; i++) {
+        SELECT_T key = arr[i];
+        int j = i - 1;
+        while (j >= 0 && SELECT_LESS(key, arr[j])) {
+            arr[j + 1] = arr[j];
+            j--;
+        }
+        arr[j + 1] = key;
+    }
+}
+
+/*
+ * ===============================================
+ *                 Quick Select
+ * ===============================================
+ */
+
+// The chosen pivot is ALWAYS the rightmost value in the given array
+int SELECT_FN(quick_partition)(SELECT_T arr[], int left, int right) {
+
+    SELECT_T pivot = arr[right];
+    int i = left;
+
+    for (int j = left; j < right; j++) {
+        if (!SELECT_LESS(pivot, arr[j])) {
+            SELECT_FN(select_swap)(&arr[i], &arr[j]);
+            i++;
+        }
+    }
+
+    SELECT_FN(select_swap)(&arr[i], &arr[right]);
+
+    return i;
+}
+
+SELECT_T SELECT_FN(quick_rec)(SELECT_T arr[], int left, int right, int k) {
+
+    while (left < right) {
+        int indexOfPivot = SELECT_FN(quick_partition)(arr, left, right);
+
+        if (indexOfPivot == k - 1) {
+            return arr[indexOfPivot];
+        } else if (indexOfPivot > k - 1) {
+            right = indexOfPivot - 1;
+        } else {
+            left = indexOfPivot + 1;
+        }
+    }
+    return arr[left];
+}
+
+// Does not modify the vector
+SELECT_T SELECT_FN(quick_select)(SELECT_T *arr, int arrLen, int kth, int mode) {
+
+    SELECT_T result;
+    memset(&result, 0, sizeof(result));
+    SELECT_T *arr_cpy = malloc(arrLen * sizeof(SELECT_T));
+    memcpy(arr_cpy, arr, arrLen * sizeof(SELECT_T));
+
+    if (mode == 0) {
+        result = SELECT_FN(quick_rec)(arr_cpy, 0, arrLen - 1, kth);
+    }
+
+    free(arr_cpy);
+    return result;
+}
+
+/*
+ * ===============================================
+ *                 Median Select
+ * ===============================================
+ */
+
+// The pivot is the median of medians, found at arr[0]
+int SELECT_FN(median_partition)(SELECT_T *arr, int arrLen) {
+
+    SELECT_T pivot = arr[0];
+    int i = arrLen - 1;
+
+    for (int j = arrLen - 1; j > 0; j--) {
+        if (!SELECT_LESS(arr[j], pivot)) {
+            SELECT_FN(select_swap)(&arr[i], &arr[j]);
+            i--;
+        }
+    }
+
+    SELECT_FN(select_swap)(&arr[i], &arr[0]);
+
+    return i;
+}
+
+// Sets the median of medians value at arr[0]
+void SELECT_FN(set_median)(SELECT_T *arr, int arrLen) {
+
+    while (arrLen > 1) {
+        int i;
+        for (i = 0; i < arrLen / 5; i++) {
+            SELECT_FN(insertionSort)(arr + i * 5, 5);
+            SELECT_FN(select_swap)(&arr[i], &arr[i * 5 + 2]);
+        }
+        if (i * 5 < arrLen) {
+            SELECT_FN(insertionSort)(arr + i * 5, arrLen % 5);
+            SELECT_FN(select_swap)(&arr[i], &arr[i * 5 + ((arrLen % 5) / 2)]);
+            i++;
+        }
+        arrLen = i;
+    }
+}
+
+SELECT_T SELECT_FN(median_rec)(SELECT_T *arr, int arrLen, int k) {
+
+    while (arrLen > 1) {
+        SELECT_FN(set_median)(arr, arrLen);
+        int indexPiv = SELECT_FN(median_partition)(arr, arrLen);
+
+        if (indexPiv == k - 1) {
+            return arr[indexPiv];
+        } else if (indexPiv > k - 1) {
+            arrLen = indexPiv;
+        } else {
+            arr += indexPiv + 1;
+            arrLen -= indexPiv + 1;
+            k -= indexPiv + 1;
+        }
+    }
+    return arr[0];
+}
+
+// Does not modify the vector
+SELECT_T SELECT_FN(median_select)(SELECT_T *arr, int arrLen, int kth, int mode) {
+
+    SELECT_T result;
+    memset(&result, 0, sizeof(result));
+    SELECT_T *arr_cpy = malloc(arrLen * sizeof(SELECT_T));
+    memcpy(arr_cpy, arr, arrLen * sizeof(SELECT_T));
+
+    if (mode == 0) {
+        result = SELECT_FN(median_rec)(arr_cpy, arrLen, kth);
+    }
+
+    free(arr_cpy);
+    return result;
+}
+
+/*
+ * ===============================================
+ *                  Heap Select
+ * ===============================================
+ */
+
+// The heapify functions and the walk are instantiated once per heap type, see GenericHeapImpl.h
+#define SELECT_HEAP   min
+#define SELECT_BEFORE(a, b) SELECT_LESS((a).value, (b).value)
+#include "GenericHeapImpl.h"
+#undef SELECT_HEAP
+#undef SELECT_BEFORE
+
+#define SELECT_HEAP   max
+#define SELECT_BEFORE(a, b) SELECT_LESS((b).value, (a).value)
+#include "GenericHeapImpl.h"
+#undef SELECT_HEAP
+#undef SELECT_BEFORE
+
+// Walks the heapify-ed heap "hp" through the auxiliary heap "aux" to find the kth element
+// "aux" must hold the root of hp and have room for kth + 1 nodes
+// type is the heapType of both heaps (0 = min, 1 = max)
+SELECT_NODE SELECT_FN(heap_rec)(SELECT_NODE *hp, int hpSize, SELECT_NODE *aux, int kth, int type) {
+
+    if (type == 0)
+        return SELECT_FN(heap_walk_min)(hp, hpSize, aux, kth);
+    return SELECT_FN(heap_walk_max)(hp, hpSize, aux, kth);
+}
+
+// Does not modify the vector
+SELECT_T SELECT_FN(heap_select)(SELECT_T *arr, int arrLen, int kth, int mode) {
+
+    SELECT_T result;
+    memset(&result, 0, sizeof(result));
+    SELECT_NODE *hp = malloc(arrLen * sizeof(SELECT_NODE));
+    SELECT_NODE *aux = malloc((arrLen + 1) * sizeof(SELECT_NODE));
+
+    for (int i = 0; i < arrLen; i++) {
+        hp[i].value = arr[i];
+    }
+
+    if (mode == 0) {
+        int type = 0;
+        if (kth > arrLen / 2) {
+            kth = arrLen - kth + 1;
+            type = 1;
+        }
+
+        for (int i = (arrLen / 2) - 1; i >= 0; --i) {
+            if (type == 0)
+                SELECT_FN(heap_Heapify_down_min)(hp, arrLen, i);
+            else
+                SELECT_FN(heap_Heapify_down_max)(hp, arrLen, i);
+        }
+        for (int i = 0; i < arrLen; i++) {
+            hp[i].index = i;
+        }
+
+        aux[0] = hp[0];
+        result = SELECT_FN(heap_rec)(hp, arrLen, aux, kth, type).value;
+    }
+
+    free(hp);
+    free(aux);
+    return result;
+}
+
+#undef SELECT_CAT_
+#undef SELECT_CAT
+#undef SELECT_FN
+#undef SELECT_NODE
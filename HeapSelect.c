@@ -5,8 +5,18 @@
  */
 
 #include "HeapSelect.h"
+#include "StreamSelect.h"
+#include "DaryHeap.h"
 #define INIT_CAPACITY 8
-#define MAX_SIZE 10000
+
+// Number of malloc / realloc calls performed on heap buffers, reported by the benchmarks
+// Per thread, like heapPool, so that benchmark workers do not share them
+_Thread_local long heapAllocations = 0;
+
+long heap_alloc_count(void){
+
+    return heapAllocations;
+}
 
 // Initializes the given heap struct
 // Requires a heapType specification : minHeap ,maxHeap or unknown
@@ -16,8 +26,10 @@ Heap *heap_init(Heap *hp, enum heapType type){
 
     hp->size = 0;
     hp->capacity = capacity;
-    hp->data = malloc(sizeof(Node *) * hp->capacity);
+    hp->data = malloc(sizeof(Node) * hp->capacity);
     hp->type = type;
+    hp->fixed = 0;
+    heapAllocations++;
 
     return hp;
 }
@@ -32,10 +44,15 @@ int heap_size(Heap *hp){
     return hp->size;
 }
 
+// Does nothing on fixed heaps, whose capacity has been chosen up front
 void heap_resize(Heap *hp, int new_capacity) {
 
-    hp->data = realloc(hp->data, sizeof(Node *) * new_capacity);
+    if (hp->fixed)
+        return;
+
+    hp->data = realloc(hp->data, sizeof(Node) * new_capacity);
     hp->capacity = new_capacity;
+    heapAllocations++;
 }
 
 Node heap_get_root(Heap *hp){
@@ -84,6 +101,7 @@ void heap_extract(Heap *hp){
 
 void heap_swap(Node *n, int index1, int index2){
 
+    OP_SWAP();
     Node temp = n[index1];
     n[index1] = n[index2];
     n[index2] = temp;
@@ -99,15 +117,18 @@ void heap_Heapify_up(Heap *hp, int index) {
     int parentValue = hp->data[parent].value;
     int indexedValue = hp->data[index].value;
 
+    OP_COMPARE(1);
     // if the heap it's a min-heap
     if (hp->type == minHeap) {
         if (parentValue > indexedValue) {
+            OP_SIFT();
             heap_swap(hp->data, parent, index);
             heap_Heapify_up(hp, parent);
         }
         // if the heap it's a max-heap
     } else if (hp->type == maxHeap) {
         if (parentValue < indexedValue) {
+            OP_SIFT();
             heap_swap(hp->data, parent, index);
             heap_Heapify_up(hp, parent);
         }
@@ -124,6 +145,7 @@ void heap_Heapify_down(Heap *hp, int index) {
     int left = heap_left_index(index);
     int right = heap_right_index(index);
 
+    OP_COMPARE((left < size) + (right < size));
     // if the heap it's a min-heap
     if (hp->type == minHeap) {
         int min;
@@ -137,6 +159,7 @@ void heap_Heapify_down(Heap *hp, int index) {
             min = right;
         }
         if (min != index) {
+            OP_SIFT();
             heap_swap(hp->data, index, min);
             heap_Heapify_down(hp, min);
         }
@@ -153,6 +176,7 @@ void heap_Heapify_down(Heap *hp, int index) {
             max = right;
         }
         if (max != index) {
+            OP_SIFT();
             heap_swap(hp->data, index, max);
             heap_Heapify_down(hp, max);
         }
@@ -161,33 +185,32 @@ void heap_Heapify_down(Heap *hp, int index) {
 
 
 // Modifies a given heap structure by inserting newly built nodes created from the standard input
+// The input is read in chunks, so it can be of any length and span any number of lines
 // Assumes the given heap has been initialized and is empty at the start
 // DOES NOT perform heapify
 void heap_buildFromStdin (Heap *hp) {
 
-    int m;
-    int t = 0;
     int num;
-    char buffer[MAX_SIZE];
-    fgets(buffer, MAX_SIZE, stdin);
+    StreamReader *reader = malloc(sizeof(StreamReader));
+    stream_reader_init(reader, stdin);
 
-    while (sscanf(buffer + t, "%d%n", &num, &m) != EOF) {
+    while (stream_next_int(reader, &num)) {
 
         int hpSize = heap_size(hp);
         int hpCapacity = heap_capacity(hp);
 
+        // resize if needed, before writing past the end of the buffer
+        if (hpCapacity == hpSize)
+            heap_resize(hp, hpCapacity * 2);
+
         // Builds node from value directly from stdin
         Node n;
         n.value = num;
         hp->data[hpSize] = n;
         hp->size++;
-
-        // resize if needed
-        if (hpCapacity == hpSize)
-            heap_resize(hp, hpCapacity * 2);
-
-        t = t + m;
     }
+
+    free(reader);
 }
 
 // Modifies a given heap structure by inserting newly built nodes created from the values of an auxiliary array
@@ -199,15 +222,15 @@ void heap_buildFromArr(int *arr, int arr_len, Heap *hp){
         int hpSize = heap_size(hp);
         int hpCapacity = heap_capacity(hp);
 
+        // resize if needed, before writing past the end of the buffer
+        if (hpCapacity == hpSize)
+            heap_resize(hp, hpCapacity * 2);
+
         // Builds node from value found at arr[i]
         Node n;
         n.value = arr[i];
         hp->data[hpSize] = n;
         hp->size++;
-
-        // resize if needed
-        if (hpCapacity == hpSize)
-            heap_resize(hp, hpCapacity * 2);
     }
 }
 
@@ -242,46 +265,138 @@ Node heap_rec(Heap *hp, Heap *hpAux, int kth){
     return heap_get_root(hpAux);
 }
 
-// Selection algorithm based on extract and an auxiliary heap structure
+enum heapBackend heapSelectBackend = binaryHeap;
+
+// Selects the heap implementation used by the following heap_select calls
+void heap_set_backend(enum heapBackend backend){
+
+    heapSelectBackend = backend;
+}
+
+// Runs heap_select's algorithm on two empty heaps provided by the caller
 // Assumes hp not to be heapify-ed yet
-int heap_select(int *arr, int arrLen, int kth, int mode){
+static int heap_select_with(Heap *hp, Heap *hpAux, int *arr, int arrLen, int kth, int mode){
 
     int result = 0;
-    Heap hp;
-    Heap hpAux;
-    heap_init(&hp, unknown);
-    heap_init(&hpAux, unknown);
-    heap_buildFromArr((int *)arr, arrLen, &hp); // Heapify still not performed at this point
+    heap_buildFromArr((int *)arr, arrLen, hp); // Heapify still not performed at this point
 
     if (mode == 0) {
         // Modifies the heap by changing its heapType depending on the value of k
         // Modifies the kth value if it is a max heap
-        int size = heap_size(&hp);
+        int size = heap_size(hp);
         if (kth <= size / 2) {
-            hp.type = minHeap;
-            hpAux.type = minHeap;
+            hp->type = minHeap;
+            hpAux->type = minHeap;
         } else {
             kth = size - kth + 1;
-            hp.type = maxHeap;
-            hpAux.type = maxHeap;
+            hp->type = maxHeap;
+            hpAux->type = maxHeap;
         }
 
         // Performs heapify to order the heap
         for (int i = (size / 2) - 1; i >= 0; --i) {
-            heap_Heapify_down(&hp, i);
+            heap_Heapify_down(hp, i);
         }
 
         // Sets the index of each of hp's nodes to that of their position in the heap
         for (int i = 0; i < size; i++) {
-            hp.data[i].index = i;
+            hp->data[i].index = i;
         }
 
-        heap_insert(&hpAux, heap_get_root(&hp));
-        Node n = heap_rec(&hp, &hpAux, kth);
+        heap_insert(hpAux, heap_get_root(hp));
+        Node n = heap_rec(hp, hpAux, kth);
         result = n.value;
     }
 
+    return result;
+}
+
+// Selection algorithm based on extract and an auxiliary heap structure
+// Assumes hp not to be heapify-ed yet
+int heap_select(int *arr, int arrLen, int kth, int mode){
+
+    if (heapSelectBackend == daryHeap)
+        return dary_select(arr, arrLen, kth, mode);
+
+    Heap hp;
+    Heap hpAux;
+    heap_init(&hp, unknown);
+    heap_init(&hpAux, unknown);
+
+    int result = heap_select_with(&hp, &hpAux, arr, arrLen, kth, mode);
+
     free(hp.data);
     free(hpAux.data);
     return result;
 }
+
+/*
+ * ===============================================
+ *                  Heap Arena
+ * ===============================================
+ */
+
+// Initializes an arena able to serve arrays of up to arrLen values without allocating
+void heap_arena_init(HeapArena *arena, int arrLen){
+
+    arena->hp.data = NULL;
+    arena->hpAux.data = NULL;
+    arena->arrLen = 0;
+    heap_arena_reserve(arena, arrLen);
+}
+
+// Grows the arena if it cannot serve arrays of arrLen values
+// hpAux gains at most one node per step of heap_rec, which runs min(k, n - k + 1) <= n / 2 + 1 steps
+void heap_arena_reserve(HeapArena *arena, int arrLen){
+
+    if (arena->arrLen >= arrLen && arena->hp.data != NULL)
+        return;
+
+    free(arena->hp.data);
+    free(arena->hpAux.data);
+    arena->arrLen = arrLen;
+    arena->hp.capacity = arrLen > 0 ? arrLen : 1;
+    arena->hpAux.capacity = arrLen / 2 + 2;
+    arena->hp.data = malloc(sizeof(Node) * arena->hp.capacity);
+    arena->hpAux.data = malloc(sizeof(Node) * arena->hpAux.capacity);
+    arena->hp.fixed = 1;
+    arena->hpAux.fixed = 1;
+    heapAllocations += 2;
+}
+
+void heap_arena_free(HeapArena *arena){
+
+    free(arena->hp.data);
+    free(arena->hpAux.data);
+    arena->hp.data = NULL;
+    arena->hpAux.data = NULL;
+    arena->arrLen = 0;
+}
+
+// Same as heap_select, but the heaps come from the arena : once the arena is large enough,
+// neither the build nor the hot loop of heap_rec perform any allocation
+int heap_select_arena(HeapArena *arena, int *arr, int arrLen, int kth, int mode){
+
+    heap_arena_reserve(arena, arrLen);
+    arena->hp.size = 0;
+    arena->hpAux.size = 0;
+    arena->hp.type = unknown;
+    arena->hpAux.type = unknown;
+
+    return heap_select_with(&arena->hp, &arena->hpAux, arr, arrLen, kth, mode);
+}
+
+_Thread_local HeapArena heapPool = {.hp.data = NULL, .hpAux.data = NULL, .arrLen = 0};
+
+// Same signature as the other selection algorithms, backed by a shared arena
+int heap_select_pooled(int *arr, int arrLen, int kth, int mode){
+
+    return heap_select_arena(&heapPool, arr, arrLen, kth, mode);
+}
+
+// Frees the calling thread's arena of heap_select_pooled
+// Must be called by benchmark threads before they exit
+void heap_pool_release(void){
+
+    heap_arena_free(&heapPool);
+}
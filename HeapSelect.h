@@ -3,6 +3,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include "OpCounters.h"
 
 struct _node{
     int value;
@@ -14,10 +15,22 @@ struct _heap {
     int size;
     int capacity;
     int type;
+    int fixed;      // if set, the capacity is never changed by insert, extract or build
 }; typedef struct _heap Heap;
 
+// Pre-sized pair of heaps reused across heap_select_arena calls :
+// hp holds the whole array, hpAux its worst case of arrLen / 2 + 2 nodes
+struct _heapArena {
+    Heap hp;
+    Heap hpAux;
+    int  arrLen;    // largest array the arena is sized for
+}; typedef struct _heapArena HeapArena;
+
 enum heapType {minHeap = 0, maxHeap = 1, unknown = 2};
 
+// Heap used by heap_select : the binary Heap below or the d-ary SoA heap of DaryHeap.h
+enum heapBackend {binaryHeap = 0, daryHeap = 1};
+
 Heap *heap_init(Heap *, enum heapType );
 int   heap_capacity(Heap *);
 int   heap_size(Heap *);
@@ -37,5 +50,14 @@ void  heap_buildFromArr(int *, int, Heap *);
 
 Node  heap_rec(Heap *, Heap *, int);
 int   heap_select(int *, int, int, int);
+void  heap_set_backend(enum heapBackend);
+
+long  heap_alloc_count(void);
+void  heap_arena_init(HeapArena *, int);
+void  heap_arena_reserve(HeapArena *, int);
+void  heap_arena_free(HeapArena *);
+int   heap_select_arena(HeapArena *, int *, int, int, int);
+int   heap_select_pooled(int *, int, int, int);
+void  heap_pool_release(void);
 
 #endif // HEAP_SELECT_H
\ No newline at end of file
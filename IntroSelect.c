@@ -0,0 +1,141 @@
+/*
+ * ===============================================
+ * 	 Implementation of Intro Select Function
+ * ===============================================
+ */
+
+#include "IntroSelect.h"
+
+// Ranges up to this size are finished with an insertion sort
+#define INTRO_SMALL 16
+// Ranges larger than this use a ninther (median of three medians of three) as pivot sample
+#define INTRO_NINTHER 128
+// Number of consecutive poor partitions tolerated before switching to median of medians
+#define INTRO_MAX_STALLS 2
+
+// Returns the index of the median value between arr[a], arr[b] and arr[c]
+static int intro_median3(int *arr, int a, int b, int c) {
+
+    if (arr[a] < arr[b]) {
+        if (arr[b] < arr[c])
+            return b;
+        return (arr[a] < arr[c]) ? c : a;
+    }
+    if (arr[a] < arr[c])
+        return a;
+    return (arr[b] < arr[c]) ? c : b;
+}
+
+// Modifies the array by moving a sampled pivot to arr[right]
+// so that quick_partition can be applied unchanged
+// The sample is a median of three for medium ranges and a ninther for large ones
+void intro_pivot(int *arr, int left, int right) {
+
+    int len = right - left + 1;
+    int mid = left + len / 2;
+    int index;
+
+    if (len > INTRO_NINTHER) {
+        int step = len / 8;
+        int a = intro_median3(arr, left, left + step, left + 2 * step);
+        int b = intro_median3(arr, mid - step, mid, mid + step);
+        int c = intro_median3(arr, right - 2 * step, right - step, right);
+        index = intro_median3(arr, a, b, c);
+    } else {
+        index = intro_median3(arr, left, mid, right);
+    }
+
+    quick_swap(&arr[index], &arr[right]);
+}
+
+// Partitions the range [left, right] around a single pivot, so that [*lt, *gt] holds
+// the values equal to it, escalating with the number of poor partitions in a row :
+// a sampled pivot and the given two-way partition first, a three-way partition after a stall,
+// so that runs of duplicates are settled in one pass, and after INTRO_MAX_STALLS stalls a pivot
+// computed with set_median, which guarantees a linear worst case
+// Shared by every engine built on intro_rec's loop
+void intro_step(int *arr, int left, int right, int stalls, partition_fn partition, int *lt, int *gt) {
+
+    int len = right - left + 1;
+
+    if (stalls == 0) {
+        intro_pivot(arr, left, right);
+        *lt = *gt = partition(arr, left, right);
+    } else if (stalls < INTRO_MAX_STALLS) {
+        intro_pivot(arr, left, right);
+        quick_partition3(arr, left, right, lt, gt);
+    } else {
+        set_median(arr + left, len);
+        median_partition3(arr + left, len, lt, gt);
+        *lt += left;
+        *gt += left;
+    }
+}
+
+// Returns the stall count after a partition shrank a range of len values to newLen :
+// incremented when less than a quarter was discarded, reset otherwise
+int intro_stalls(int stalls, int len, int newLen) {
+
+    return newLen > len - len / 4 ? stalls + 1 : 0;
+}
+
+// Iteratively partitions the range [left, right] with intro_step until k - 1 falls among
+// the values equal to the pivot, the two-way steps being performed by the given partition
+// Uses constant stack space (set_median aside), unlike quick_rec and median_rec
+// Returns the kth smallest element in the array
+int intro_loop(int arr[], int left, int right, int k, partition_fn partition) {
+
+    int stalls = 0;
+
+    while (right > left) {
+
+        int len = right - left + 1;
+        int lt, gt;
+
+        if (len <= INTRO_SMALL) {
+            insertionSort(arr + left, len);
+            return arr[k - 1];
+        }
+
+        intro_step(arr, left, right, stalls, partition, &lt, &gt);
+
+        // if k falls in the band of values equal to the pivot
+        if (k - 1 >= lt && k - 1 <= gt) {
+            return arr[k - 1];
+            // if k falls among the smaller values
+        } else if (k - 1 < lt) {
+            right = lt - 1;
+            // if k falls among the greater values
+        } else {
+            left = gt + 1;
+        }
+
+        // Tracks how far the partition shrank the active range
+        stalls = intro_stalls(stalls, len, right - left + 1);
+    }
+
+    return arr[left];
+}
+
+// intro_loop with quick_partition as two-way partition
+// Returns the kth smallest element in the array
+int intro_rec(int arr[], int left, int right, int k) {
+
+    return intro_loop(arr, left, right, k, quick_partition);
+}
+
+// Returns the kth smallest value in the given vector
+// Does not modify the vector
+int intro_select(int *arr, int arrLen, int kth, int mode){
+
+    int result = 0;
+    int *arr_cpy = malloc(arrLen * sizeof(int));
+    memcpy(arr_cpy, (int *)arr, arrLen * sizeof(int));
+
+    if (mode == 0) {
+        result = intro_rec(arr_cpy, 0, arrLen - 1, kth);
+    }
+
+    free(arr_cpy);
+    return result;
+}
@@ -0,0 +1,21 @@
+#ifndef INTRO_SELECT_H
+#define INTRO_SELECT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "QuickSelect.h"
+#include "MedianSelect.h"
+
+// Two-way partition following quick_partition's contract : the pivot is arr[right],
+// values <= pivot end up on its left, values > pivot on its right, and the new index of the pivot is returned
+typedef int (*partition_fn)(int *, int, int);
+
+void intro_pivot(int *, int, int);
+void intro_step(int *, int, int, int, partition_fn, int *, int *);
+int  intro_stalls(int, int, int);
+int  intro_loop(int *, int, int, int, partition_fn);
+int  intro_rec(int *, int, int, int);
+int  intro_select(int *, int, int, int);
+
+#endif // INTRO_SELECT_H
@@ -20,7 +20,8 @@ void insertionSort(int *arr, int arrLen) {
     for (i = 1; i < arrLen; i++) {
         key = arr[i];
         j = i - 1;
-        while (j >= 0 && arr[j] > key) {
+        while (j >= 0 && (OP_COMPARE(1), arr[j] > key)) {
+            OP_SWAP();
             arr[j + 1] = arr[j];
             j = j - 1;
         }
@@ -30,6 +31,7 @@ void insertionSort(int *arr, int arrLen) {
 
 void median_swap(int *a, int *b) {
 
+    OP_SWAP();
     int temp = *a;
     *a = *b;
     *b = temp;
@@ -46,6 +48,8 @@ int median_partition(int *arr, int arrLen) {
     int i = arrLen - 1;
     int j;
 
+    OP_PASS();
+    OP_COMPARE(arrLen - 1);
     for (j = arrLen - 1; j > 0; j--) {
         if (arr[j] >= pivot){
             median_swap(&arr[i], &arr[j]);
@@ -58,12 +62,44 @@ int median_partition(int *arr, int arrLen) {
     return i;
 }
 
+// Three-way (Dutch national flag) version of median_partition
+// Modifies the array so that [0, *lt) holds the values smaller than the pivot,
+// [*lt, *gt] the values equal to it and (*gt, arrLen) the values greater than it
+
+// The pivot is the median of medians, found at arr[0]
+void median_partition3(int *arr, int arrLen, int *lt, int *gt) {
+
+    int pivot = arr[0];
+    int l = 0;
+    int i = 0;
+    int g = arrLen - 1;
+
+    OP_PASS();
+    while (i <= g) {
+        OP_COMPARE(1);
+        if (arr[i] < pivot) {
+            median_swap(&arr[l], &arr[i]);
+            l++;
+            i++;
+        } else if (arr[i] > pivot) {
+            median_swap(&arr[i], &arr[g]);
+            g--;
+        } else {
+            i++;
+        }
+    }
+
+    *lt = l;
+    *gt = g;
+}
+
 // Sets the median value at arr[0]
 void set_median(int *arr, int arrLen) {
 
     // Median values of each of the 5-sized subgroups ( included the last one which could be <5-sized )
     // are stored from arr[0] onwards by performing swaps, so that an in-place implementation can be achieved
 
+    OP_ENTER();
     int i;
     for (i = 0; i < arrLen / 5; i++) { // Finds the median n/5 times
 
@@ -80,6 +116,7 @@ void set_median(int *arr, int arrLen) {
     if (i != 1) { // There are more than 1 subgroups, meaning the median of medians value is not yet found
         set_median(arr, i);
     }
+    OP_LEAVE();
 }
 
 // Recursively applies partition and itself until the array is partitioned in such a way
@@ -88,22 +125,53 @@ void set_median(int *arr, int arrLen) {
 
 int median_rec(int *arr, int arrLen, int k){
 
+    int result;
+    OP_ENTER();
     set_median(arr, arrLen);
     int indexPiv = median_partition(arr, arrLen);
 
     // if the index of the pivot is the same as k
     if (indexPiv == k - 1) {
         // return the value at its position
-        return arr[indexPiv];
+        result = arr[indexPiv];
         // if the index of the pivot is greater than k
     } else if (indexPiv > k - 1) {
         // recursion on the left partition of the array
-        return median_rec(arr, indexPiv, k);
+        result = median_rec(arr, indexPiv, k);
         // if the index of the pivot is greater than k
     } else {
         // recursion on the right partition of the array
-        return median_rec(arr + indexPiv + 1, arrLen - indexPiv - 1, k - indexPiv - 1);
+        result = median_rec(arr + indexPiv + 1, arrLen - indexPiv - 1, k - indexPiv - 1);
     }
+
+    OP_LEAVE();
+    return result;
+}
+
+// Same as median_rec with a three-way partition : values equal to the pivot are never
+// partitioned again, and the recursion stops as soon as k falls among them
+// Returns the kth smallest element in the array
+int median_rec3(int *arr, int arrLen, int k){
+
+    int result;
+    int lt, gt;
+    OP_ENTER();
+    set_median(arr, arrLen);
+    median_partition3(arr, arrLen, &lt, &gt);
+
+    // if k falls in the band of values equal to the pivot
+    if (k - 1 >= lt && k - 1 <= gt) {
+        result = arr[k - 1];
+        // if k falls among the smaller values
+    } else if (k - 1 < lt) {
+        result = median_rec3(arr, lt, k);
+        // if k falls among the greater values
+    } else {
+        result = median_rec3(arr + gt + 1, arrLen - gt - 1, k - gt - 1);
+    }
+
+    OP_LEAVE();
+    return result;
 }
 
 // Returns the kth smallest value in the given vector
@@ -120,4 +188,42 @@ int median_select(int *arr, int arrLen, int kth, int mode){
 
     free(arr_cpy);
     return result;
-}
\ No newline at end of file
+}
+
+// Returns the kth smallest value in the given vector using three-way partitions
+// Does not modify the vector
+int median_select3(int *arr, int arrLen, int kth, int mode){
+
+    int result = 0;
+    int *arr_cpy = malloc(arrLen * sizeof(int));
+    memcpy(arr_cpy, (int *)arr, arrLen * sizeof(int));
+
+    if (mode == 0) {
+        result = median_rec3(arr_cpy, arrLen, kth);
+    }
+
+    free(arr_cpy);
+    return result;
+}
+
+// Returns the kth smallest value in the given vector without copying it
+// Modifies the vector: its values are permuted by the partitions
+int median_select_inplace(int *arr, int arrLen, int kth, int mode){
+
+    int result = 0;
+
+    if (mode == 0) {
+        result = median_rec(arr, arrLen, kth);
+    }
+
+    return result;
+}
+
+// Returns the kth smallest value in the given vector
+// Does not modify the vector: its values are copied to the caller-owned scratch buffer,
+// which must hold at least arrLen values, so that repeated queries perform no allocation
+int median_select_scratch(int *arr, int arrLen, int kth, int *scratch){
+
+    memcpy(scratch, (int *)arr, arrLen * sizeof(int));
+    return median_rec(scratch, arrLen, kth);
+}
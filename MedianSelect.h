@@ -4,12 +4,18 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "OpCounters.h"
 
 void median_swap(int *, int *);
 int  median_partition(int *, int);
+void median_partition3(int *, int, int *, int *);
 void insertionSort(int *, int);
 void set_median(int *, int);
 int  median_rec(int *, int, int);
+int  median_rec3(int *, int, int);
 int  median_select(int *, int, int, int);
+int  median_select3(int *, int, int, int);
+int  median_select_inplace(int *, int, int, int);
+int  median_select_scratch(int *, int, int, int *);
 
 #endif // MEDIAN_SELECT_H
\ No newline at end of file
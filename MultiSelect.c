@@ -0,0 +1,91 @@
+/*
+ * ===============================================
+ * 	 Implementation of Multi Select Function
+ * ===============================================
+ */
+
+#include "MultiSelect.h"
+
+// Ranges up to this size are sorted and every remaining rank is read directly
+#define MULTI_SMALL 16
+
+// Finds every rank ks[order[lo]] ... ks[order[hi - 1]] inside the range [left, right]
+// "order" lists the indexes of ks sorted by increasing rank, results are written to out[order[i]]
+// Each partition is an intro_step and splits the requested ranks: the side holding fewer of them
+// is handled recursively and the other one by the loop, so the recursion depth is at most log2(number of ranks)
+// A side that holds a single rank is finished by intro_rec
+void multi_rec(int arr[], int left, int right, const int *ks, const int *order, int lo, int hi, int *out) {
+
+    int stalls = 0;
+
+    while (lo < hi) {
+
+        int len = right - left + 1;
+
+        if (hi - lo == 1) {
+            out[order[lo]] = intro_rec(arr, left, right, ks[order[lo]]);
+            return;
+        }
+
+        if (len <= MULTI_SMALL) {
+            insertionSort(arr + left, len);
+            for (int i = lo; i < hi; i++) {
+                out[order[i]] = arr[ks[order[i]] - 1];
+            }
+            return;
+        }
+
+        int lt, gt;
+        intro_step(arr, left, right, stalls, quick_partition, &lt, &gt);
+
+        // ranks in [lo, mid) are left of the equal band, ranks in [after, hi) are right of it,
+        // ranks in between are answered directly
+        int mid = lo;
+        while (mid < hi && ks[order[mid]] - 1 < lt) {
+            mid++;
+        }
+        int after = mid;
+        while (after < hi && ks[order[after]] - 1 <= gt) {
+            out[order[after]] = arr[ks[order[after]] - 1];
+            after++;
+        }
+
+        if (mid - lo < hi - after) {
+            multi_rec(arr, left, lt - 1, ks, order, lo, mid, out);
+            left = gt + 1;
+            lo = after;
+        } else {
+            multi_rec(arr, gt + 1, right, ks, order, after, hi, out);
+            right = lt - 1;
+            hi = mid;
+        }
+
+        // Tracks how far the partition shrank the active range
+        stalls = intro_stalls(stalls, len, right - left + 1);
+    }
+}
+
+// Writes the ks[i]th smallest value of the given vector to out[i] for every one of the nk ranks
+// Ranks do not need to be sorted or distinct
+// Does not modify the vector: a single copy is shared by all the ranks
+void multi_select(int *arr, int arrLen, const int *ks, int nk, int *out){
+
+    int *arr_cpy = malloc(arrLen * sizeof(int));
+    int *order = malloc(nk * sizeof(int));
+    memcpy(arr_cpy, (int *)arr, arrLen * sizeof(int));
+
+    // Sorts the indexes of ks by increasing rank
+    for (int i = 0; i < nk; i++) {
+        int j = i - 1;
+        while (j >= 0 && ks[order[j]] > ks[i]) {
+            order[j + 1] = order[j];
+            j--;
+        }
+        order[j + 1] = i;
+    }
+
+    multi_rec(arr_cpy, 0, arrLen - 1, ks, order, 0, nk, out);
+
+    free(order);
+    free(arr_cpy);
+}
@@ -0,0 +1,14 @@
+#ifndef MULTI_SELECT_H
+#define MULTI_SELECT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "QuickSelect.h"
+#include "MedianSelect.h"
+#include "IntroSelect.h"
+
+void multi_rec(int *, int, int, const int *, const int *, int, int, int *);
+void multi_select(int *, int, const int *, int, int *);
+
+#endif // MULTI_SELECT_H
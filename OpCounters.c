@@ -0,0 +1,39 @@
+/*
+ * ===============================================
+ *     Operation Counters of the Engines
+ * ===============================================
+ */
+
+#include "OpCounters.h"
+
+#ifdef SELECT_COUNT_OPS
+// Per thread, so that benchmark workers count their own calls
+_Thread_local OpCounters opCounters;
+#endif
+
+// Returns 1 if the program was compiled with -DSELECT_COUNT_OPS
+int op_enabled(void) {
+
+#ifdef SELECT_COUNT_OPS
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+void op_reset(void) {
+
+#ifdef SELECT_COUNT_OPS
+    memset(&opCounters, 0, sizeof(OpCounters));
+#endif
+}
+
+// Copies the counts since the last op_reset; all zero when counting is compiled out
+void op_read(OpCounters *counters) {
+
+#ifdef SELECT_COUNT_OPS
+    *counters = opCounters;
+#else
+    memset(counters, 0, sizeof(OpCounters));
+#endif
+}
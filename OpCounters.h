@@ -0,0 +1,45 @@
+#ifndef OP_COUNTERS_H
+#define OP_COUNTERS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Operation counts of the selection engines
+// Only compiled in with -DSELECT_COUNT_OPS : otherwise every OP_ macro expands to nothing
+struct _opCounters {
+    long long comparisons;      // comparisons between two values of the input
+    long long swaps;            // swaps and single element moves
+    long long passes;           // partition passes
+    long long siftSteps;        // levels climbed or descended by heap sift operations
+    int depth;                  // current recursion depth
+    int maxDepth;               // deepest recursion since the last op_reset
+}; typedef struct _opCounters OpCounters;
+
+#ifdef SELECT_COUNT_OPS
+
+extern _Thread_local OpCounters opCounters;
+
+#define OP_COMPARE(n) (opCounters.comparisons += (n))
+#define OP_SWAP()     (opCounters.swaps++)
+#define OP_PASS()     (opCounters.passes++)
+#define OP_SIFT()     (opCounters.siftSteps++)
+#define OP_ENTER()    do { if (++opCounters.depth > opCounters.maxDepth) opCounters.maxDepth = opCounters.depth; } while (0)
+#define OP_LEAVE()    (opCounters.depth--)
+
+#else
+
+#define OP_COMPARE(n) ((void)0)
+#define OP_SWAP()     ((void)0)
+#define OP_PASS()     ((void)0)
+#define OP_SIFT()     ((void)0)
+#define OP_ENTER()    ((void)0)
+#define OP_LEAVE()    ((void)0)
+
+#endif
+
+int  op_enabled(void);
+void op_reset(void);
+void op_read(OpCounters *);
+
+#endif // OP_COUNTERS_H
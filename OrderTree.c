@@ -0,0 +1,280 @@
+/*
+ * ===============================================
+ *     Dynamic Order Statistics with a Treap
+ * ===============================================
+ */
+
+#include "OrderTree.h"
+
+// Seed of the node priorities : the shape of a treap does not depend on it on average
+#define ORDER_SEED 0x9E3779B97F4A7C15ULL
+
+// Initializes an empty tree whose pool holds capacity nodes before growing
+void order_tree_init(OrderTree *t, int capacity) {
+
+    t->capacity = capacity > 0 ? capacity + 1 : 2;
+    t->nodes = malloc(t->capacity * sizeof(OrderNode));
+    t->nodes[0].value = 0;
+    t->nodes[0].count = 0;
+    t->nodes[0].size = 0;
+    t->nodes[0].priority = 0;
+    t->nodes[0].left = 0;
+    t->nodes[0].right = 0;
+    t->used = 1;
+    t->freeList = 0;
+    t->root = 0;
+    gen_seed(&t->rng, ORDER_SEED);
+}
+
+void order_tree_free(OrderTree *t) {
+
+    free(t->nodes);
+    t->nodes = NULL;
+    t->capacity = 0;
+    t->used = 0;
+    t->root = 0;
+}
+
+// Number of values in the tree, duplicates included
+int order_tree_size(const OrderTree *t) {
+
+    return t->nodes[t->root].size;
+}
+
+// Takes a node from the free list, or from the end of the pool
+// May move the pool : indexes stay valid, pointers to nodes do not
+static int order_node_new(OrderTree *t, int value) {
+
+    int node;
+
+    if (t->freeList != 0) {
+        node = t->freeList;
+        t->freeList = t->nodes[node].left;
+    } else {
+        if (t->used == t->capacity) {
+            t->capacity *= 2;
+            t->nodes = realloc(t->nodes, t->capacity * sizeof(OrderNode));
+        }
+        node = t->used++;
+    }
+
+    OrderNode *n = &t->nodes[node];
+    n->value = value;
+    n->count = 1;
+    n->size = 1;
+    n->priority = (uint32_t)gen_next(&t->rng);
+    n->left = 0;
+    n->right = 0;
+    return node;
+}
+
+static void order_node_release(OrderTree *t, int node) {
+
+    t->nodes[node].left = t->freeList;
+    t->freeList = node;
+}
+
+static void order_update(OrderTree *t, int node) {
+
+    OrderNode *n = &t->nodes[node];
+    n->size = t->nodes[n->left].size + n->count + t->nodes[n->right].size;
+}
+
+// Lifts the left child of node above it, returns the new subtree root
+static int order_rotate_right(OrderTree *t, int node) {
+
+    int child = t->nodes[node].left;
+    t->nodes[node].left = t->nodes[child].right;
+    t->nodes[child].right = node;
+    order_update(t, node);
+    order_update(t, child);
+    return child;
+}
+
+// Lifts the right child of node above it, returns the new subtree root
+static int order_rotate_left(OrderTree *t, int node) {
+
+    int child = t->nodes[node].right;
+    t->nodes[node].right = t->nodes[child].left;
+    t->nodes[child].left = node;
+    order_update(t, node);
+    order_update(t, child);
+    return child;
+}
+
+// Inserts value in the subtree rooted at node, returns the new subtree root
+static int order_insert_rec(OrderTree *t, int node, int value) {
+
+    if (node == 0)
+        return order_node_new(t, value);
+
+    if (value == t->nodes[node].value) {
+        t->nodes[node].count++;
+    } else if (value < t->nodes[node].value) {
+        int child = order_insert_rec(t, t->nodes[node].left, value);
+        t->nodes[node].left = child;
+        if (t->nodes[child].priority > t->nodes[node].priority)
+            return order_rotate_right(t, node);
+    } else {
+        int child = order_insert_rec(t, t->nodes[node].right, value);
+        t->nodes[node].right = child;
+        if (t->nodes[child].priority > t->nodes[node].priority)
+            return order_rotate_left(t, node);
+    }
+
+    order_update(t, node);
+    return node;
+}
+
+// Removes one occurrence of value from the subtree rooted at node, returns the new subtree root
+// Sets *found if value was there
+static int order_erase_rec(OrderTree *t, int node, int value, int *found) {
+
+    if (node == 0)
+        return 0;
+
+    OrderNode *n = &t->nodes[node];
+
+    if (value < n->value) {
+        n->left = order_erase_rec(t, n->left, value, found);
+    } else if (value > n->value) {
+        n->right = order_erase_rec(t, n->right, value, found);
+    } else if (n->count > 1) {
+        n->count--;
+        *found = 1;
+    } else if (n->left == 0 || n->right == 0) {
+        int child = n->left != 0 ? n->left : n->right;
+        order_node_release(t, node);
+        *found = 1;
+        return child;
+    } else {
+        // Rotates the node down below its higher priority child, then erases it from there
+        if (t->nodes[n->left].priority > t->nodes[n->right].priority) {
+            node = order_rotate_right(t, node);
+            t->nodes[node].right = order_erase_rec(t, t->nodes[node].right, value, found);
+        } else {
+            node = order_rotate_left(t, node);
+            t->nodes[node].left = order_erase_rec(t, t->nodes[node].left, value, found);
+        }
+    }
+
+    order_update(t, node);
+    return node;
+}
+
+static int order_compare(const void *a, const void *b) {
+
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+// Sets the size of every node of the subtree rooted at node, returns it
+static int order_size_rec(OrderTree *t, int node) {
+
+    if (node == 0)
+        return 0;
+    OrderNode *n = &t->nodes[node];
+    n->size = order_size_rec(t, n->left) + n->count + order_size_rec(t, n->right);
+    return n->size;
+}
+
+// Replaces the content of the tree with the values of the array
+// Sorts a copy, then links the distinct values as a treap in one pass with a stack
+// of the right spine, which beats arrLen inserts by an order of magnitude
+void order_tree_build(OrderTree *t, const int *arr, int arrLen) {
+
+    int *sorted = malloc((arrLen > 0 ? arrLen : 1) * sizeof(int));
+    int *spine = malloc((arrLen > 0 ? arrLen : 1) * sizeof(int));
+    int depth = 0;
+
+    if (arrLen > 0) {
+        memcpy(sorted, arr, arrLen * sizeof(int));
+        qsort(sorted, arrLen, sizeof(int), order_compare);
+    }
+
+    t->used = 1;
+    t->freeList = 0;
+    t->root = 0;
+
+    for (int i = 0; i < arrLen; i++) {
+        if (depth > 0 && t->nodes[spine[depth - 1]].value == sorted[i]) {
+            t->nodes[spine[depth - 1]].count++;
+            continue;
+        }
+
+        int node = order_node_new(t, sorted[i]);
+        int last = 0;
+        while (depth > 0 && t->nodes[spine[depth - 1]].priority < t->nodes[node].priority) {
+            last = spine[--depth];
+        }
+        t->nodes[node].left = last;
+        if (depth > 0)
+            t->nodes[spine[depth - 1]].right = node;
+        spine[depth++] = node;
+    }
+
+    t->root = depth > 0 ? spine[0] : 0;
+    order_size_rec(t, t->root);
+
+    free(spine);
+    free(sorted);
+}
+
+// Adds one occurrence of value to the tree
+void order_tree_insert(OrderTree *t, int value) {
+
+    t->root = order_insert_rec(t, t->root, value);
+}
+
+// Removes one occurrence of value from the tree
+// Returns 0 if the tree did not hold it
+int order_tree_erase(OrderTree *t, int value) {
+
+    int found = 0;
+    t->root = order_erase_rec(t, t->root, value, &found);
+    return found;
+}
+
+// Returns the kth smallest value of the tree, 1 <= k <= order_tree_size
+int order_tree_kth(const OrderTree *t, int kth) {
+
+    int node = t->root;
+
+    while (node != 0) {
+        const OrderNode *n = &t->nodes[node];
+        int leftSize = t->nodes[n->left].size;
+
+        if (kth <= leftSize) {
+            node = n->left;
+        } else if (kth <= leftSize + n->count) {
+            return n->value;
+        } else {
+            kth -= leftSize + n->count;
+            node = n->right;
+        }
+    }
+    return 0;
+}
+
+// Returns the number of values in the tree strictly smaller than value,
+// so that value would be the (rank + 1)th smallest once inserted
+int order_tree_rank(const OrderTree *t, int value) {
+
+    int node = t->root;
+    int rank = 0;
+
+    while (node != 0) {
+        const OrderNode *n = &t->nodes[node];
+
+        if (value <= n->value) {
+            if (value == n->value)
+                return rank + t->nodes[n->left].size;
+            node = n->left;
+        } else {
+            rank += t->nodes[n->left].size + n->count;
+            node = n->right;
+        }
+    }
+    return rank;
+}
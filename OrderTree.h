@@ -0,0 +1,41 @@
+#ifndef ORDER_TREE_H
+#define ORDER_TREE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Generator.h"
+
+// Node of a treap augmented with subtree sizes
+// Children are indexes in the tree's node pool, 0 being the empty subtree
+struct _orderNode {
+    int value;
+    int count;              // occurrences of value
+    int size;               // occurrences held by the subtree
+    uint32_t priority;      // max-heap ordered
+    int left;
+    int right;
+}; typedef struct _orderNode OrderNode;
+
+// Multiset of ints supporting insert, erase, kth and rank in O(log n) expected time
+// Nodes live in one pool grown by doubling, erased nodes are chained in a free list
+// through their left field, so the tree never allocates per operation
+struct _orderTree {
+    OrderNode *nodes;       // nodes[0] is the empty subtree, with size 0
+    int capacity;
+    int used;               // nodes handed out so far, free ones included
+    int freeList;
+    int root;
+    GenRng rng;             // node priorities
+}; typedef struct _orderTree OrderTree;
+
+void order_tree_init(OrderTree *, int);
+void order_tree_free(OrderTree *);
+void order_tree_build(OrderTree *, const int *, int);
+int  order_tree_size(const OrderTree *);
+void order_tree_insert(OrderTree *, int);
+int  order_tree_erase(OrderTree *, int);
+int  order_tree_kth(const OrderTree *, int);
+int  order_tree_rank(const OrderTree *, int);
+
+#endif // ORDER_TREE_H
@@ -0,0 +1,338 @@
+/*
+ * ===============================================
+ * 	 Implementation of Parallel Select Function
+ * ===============================================
+ */
+
+#include "ParallelSelect.h"
+#include <math.h>
+#include <unistd.h>
+
+// Once the active range is this small, it is finished by intro_rec on a single thread
+#define PARALLEL_FINISH (1 << 18)
+// Total number of values sampled to choose the pivots of each round
+#define PARALLEL_SAMPLE 4096
+// Width of the pivot band around the expected rank, in standard deviations of the sample rank
+#define PARALLEL_BAND 3.0
+
+/*
+ * ===============================================
+ *                  Thread pool
+ * ===============================================
+ */
+
+struct _poolWorker {
+    ThreadPool *pool;
+    int tid;
+};
+
+static void *pool_worker(void *arg) {
+
+    struct _poolWorker *worker = arg;
+    ThreadPool *pool = worker->pool;
+    int tid = worker->tid;
+    int seen = 0;
+    free(worker);
+
+    for (;;) {
+        pthread_mutex_lock(&pool->lock);
+        while (!pool->stop && pool->generation == seen)
+            pthread_cond_wait(&pool->start, &pool->lock);
+        if (pool->stop) {
+            pthread_mutex_unlock(&pool->lock);
+            return NULL;
+        }
+        seen = pool->generation;
+        pthread_mutex_unlock(&pool->lock);
+
+        pool->job(pool->ctx, tid);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->pending == 0)
+            pthread_cond_signal(&pool->done);
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
+
+// Creates a pool of nthreads - 1 workers, the thread calling pool_run acting as the last one
+ThreadPool *pool_create(int nthreads) {
+
+    ThreadPool *pool = malloc(sizeof(ThreadPool));
+
+    pool->nthreads = nthreads < 1 ? 1 : nthreads;
+    pool->threads = malloc(pool->nthreads * sizeof(pthread_t));
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->start, NULL);
+    pthread_cond_init(&pool->done, NULL);
+    pool->job = NULL;
+    pool->ctx = NULL;
+    pool->generation = 0;
+    pool->pending = 0;
+    pool->stop = 0;
+
+    for (int i = 1; i < pool->nthreads; i++) {
+        struct _poolWorker *worker = malloc(sizeof(struct _poolWorker));
+        worker->pool = pool;
+        worker->tid = i;
+        pthread_create(&pool->threads[i], NULL, pool_worker, worker);
+    }
+    return pool;
+}
+
+// Runs job(ctx, tid) on every thread of the pool, tid going from 0 (the caller) to nthreads - 1
+// Returns once every thread has finished
+void pool_run(ThreadPool *pool, void (*job)(void *, int), void *ctx) {
+
+    pthread_mutex_lock(&pool->lock);
+    pool->job = job;
+    pool->ctx = ctx;
+    pool->pending = pool->nthreads - 1;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+
+    job(ctx, 0);
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->pending > 0)
+        pthread_cond_wait(&pool->done, &pool->lock);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+void pool_destroy(ThreadPool *pool) {
+
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = 1;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (int i = 1; i < pool->nthreads; i++)
+        pthread_join(pool->threads[i], NULL);
+
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->start);
+    pthread_cond_destroy(&pool->done);
+    free(pool->threads);
+    free(pool);
+}
+
+// Thread count used by parallel_select, 0 meaning every online core
+int parallelThreads = 0;
+ThreadPool *parallelPool = NULL;
+
+void parallel_set_threads(int nthreads) {
+
+    parallelThreads = nthreads;
+}
+
+int parallel_get_threads(void) {
+
+    if (parallelThreads > 0)
+        return parallelThreads;
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    return cores > 0 ? (int)cores : 1;
+}
+
+// Returns the shared pool, (re)created whenever the thread count changes
+ThreadPool *parallel_pool(void) {
+
+    int nthreads = parallel_get_threads();
+
+    if (parallelPool != NULL && parallelPool->nthreads != nthreads) {
+        pool_destroy(parallelPool);
+        parallelPool = NULL;
+    }
+    if (parallelPool == NULL)
+        parallelPool = pool_create(nthreads);
+    return parallelPool;
+}
+
+/*
+ * ===============================================
+ *               Parallel selection
+ * ===============================================
+ */
+
+// Shared state of a selection round
+struct _parallelRound {
+    const int *src;
+    int *dst;
+    long n;
+    int nthreads;
+    int round;
+    int lo, hi;                  // pivot band [lo, hi]
+    int band;                    // 0 : values < lo, 1 : values in [lo, hi], 2 : values > hi
+    int *sample;                 // PARALLEL_SAMPLE values
+    long *counts;                // 3 counters per thread
+    long *offsets;               // start of each thread's output in dst
+};
+
+static void parallel_chunk(struct _parallelRound *r, int tid, long *begin, long *end) {
+
+    *begin = r->n * tid / r->nthreads;
+    *end = r->n * (tid + 1) / r->nthreads;
+}
+
+// Each thread draws its share of the sample from its own chunk
+static void parallel_sample_job(void *ctx, int tid) {
+
+    struct _parallelRound *r = ctx;
+    long begin, end;
+    parallel_chunk(r, tid, &begin, &end);
+    int first = PARALLEL_SAMPLE * tid / r->nthreads;
+    int last = PARALLEL_SAMPLE * (tid + 1) / r->nthreads;
+    unsigned long long state = 0x9E3779B97F4A7C15ULL * (unsigned long long)(r->round * r->nthreads + tid + 1);
+
+    for (int i = first; i < last; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        r->sample[i] = (end > begin) ? r->src[begin + (long)(state % (unsigned long long)(end - begin))]
+                                     : r->src[r->n / 2];
+    }
+}
+
+// Each thread counts the values of its chunk below, inside and above the pivot band
+static void parallel_count_job(void *ctx, int tid) {
+
+    struct _parallelRound *r = ctx;
+    long begin, end;
+    parallel_chunk(r, tid, &begin, &end);
+    long less = 0, greater = 0;
+    int lo = r->lo, hi = r->hi;
+
+    for (long i = begin; i < end; i++) {
+        less += (r->src[i] < lo);
+        greater += (r->src[i] > hi);
+    }
+    r->counts[tid * 3] = less;
+    r->counts[tid * 3 + 1] = (end - begin) - less - greater;
+    r->counts[tid * 3 + 2] = greater;
+}
+
+// Each thread copies the values of its chunk that belong to the chosen band at its own offset in dst
+static void parallel_scatter_job(void *ctx, int tid) {
+
+    struct _parallelRound *r = ctx;
+    long begin, end;
+    parallel_chunk(r, tid, &begin, &end);
+    int *out = r->dst + r->offsets[tid];
+    int lo = r->lo, hi = r->hi;
+
+    for (long i = begin; i < end; i++) {
+        int value = r->src[i];
+        int band = (value < lo) ? 0 : ((value > hi) ? 2 : 1);
+        if (band == r->band)
+            *out++ = value;
+    }
+}
+
+static int parallel_compare(const void *a, const void *b) {
+
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+// Returns the kth smallest value in the given vector
+// Each round samples pivots in parallel, picks a band [lo, hi] expected to contain the kth value,
+// counts the three bands in parallel and scatters only the one holding k into a new buffer
+// Does not modify the vector
+int parallel_select(int *arr, int arrLen, int kth, int mode){
+
+    int result = 0;
+    int *bufA = malloc(arrLen * sizeof(int));
+    int *bufB = NULL;
+
+    if (mode == 0) {
+        ThreadPool *pool = parallel_pool();
+        struct _parallelRound r;
+        long k = kth;
+        int found = 0;
+
+        r.src = arr;
+        r.n = arrLen;
+        r.nthreads = pool->nthreads;
+        r.sample = malloc(PARALLEL_SAMPLE * sizeof(int));
+        r.counts = malloc(3 * r.nthreads * sizeof(long));
+        r.offsets = malloc(r.nthreads * sizeof(long));
+
+        for (r.round = 0; r.n > PARALLEL_FINISH; r.round++) {
+
+            pool_run(pool, parallel_sample_job, &r);
+            qsort(r.sample, PARALLEL_SAMPLE, sizeof(int), parallel_compare);
+
+            double expected = (double)k / r.n * PARALLEL_SAMPLE;
+            double delta = PARALLEL_BAND * sqrt(PARALLEL_SAMPLE) / 2;
+            int loIndex = (int)(expected - delta);
+            int hiIndex = (int)(expected + delta);
+            r.lo = r.sample[loIndex < 0 ? 0 : loIndex];
+            r.hi = r.sample[hiIndex >= PARALLEL_SAMPLE ? PARALLEL_SAMPLE - 1 : hiIndex];
+
+            pool_run(pool, parallel_count_job, &r);
+            long less = 0, inside = 0;
+            for (int t = 0; t < r.nthreads; t++) {
+                less += r.counts[t * 3];
+                inside += r.counts[t * 3 + 1];
+            }
+
+            long bandLen;
+            if (k <= less) {
+                r.band = 0;
+                bandLen = less;
+            } else if (k > less + inside) {
+                r.band = 2;
+                bandLen = r.n - less - inside;
+                k -= less + inside;
+            } else {
+                r.band = 1;
+                bandLen = inside;
+                k -= less;
+                // Every value of the band is the same : it is the kth
+                if (r.lo == r.hi) {
+                    result = r.lo;
+                    found = 1;
+                    break;
+                }
+            }
+
+            // No progress possible (e.g. very few distinct values) : finish on a single thread
+            if (bandLen == r.n)
+                break;
+
+            long offset = 0;
+            for (int t = 0; t < r.nthreads; t++) {
+                r.offsets[t] = offset;
+                offset += r.counts[t * 3 + r.band];
+            }
+
+            // The band is scattered into whichever buffer is not being read
+            if (r.src == bufA) {
+                if (bufB == NULL)
+                    bufB = malloc(bandLen * sizeof(int));
+                r.dst = bufB;
+            } else {
+                r.dst = bufA;
+            }
+            pool_run(pool, parallel_scatter_job, &r);
+            r.src = r.dst;
+            r.n = bandLen;
+        }
+
+        if (!found) {
+            if (r.src == arr) {
+                memcpy(bufA, arr, r.n * sizeof(int));
+                r.src = bufA;
+            }
+            result = intro_rec((int *)r.src, 0, (int)r.n - 1, (int)k);
+        }
+
+        free(r.sample);
+        free(r.counts);
+        free(r.offsets);
+    }
+
+    free(bufA);
+    free(bufB);
+    return result;
+}
@@ -0,0 +1,32 @@
+#ifndef PARALLEL_SELECT_H
+#define PARALLEL_SELECT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "IntroSelect.h"
+
+struct _threadPool {
+    pthread_t *threads;
+    int nthreads;                // workers + the calling thread
+    pthread_mutex_t lock;
+    pthread_cond_t start;
+    pthread_cond_t done;
+    void (*job)(void *, int);
+    void *ctx;
+    int generation;
+    int pending;
+    int stop;
+}; typedef struct _threadPool ThreadPool;
+
+ThreadPool *pool_create(int);
+void        pool_run(ThreadPool *, void (*job)(void *, int), void *);
+void        pool_destroy(ThreadPool *);
+
+void parallel_set_threads(int);
+int  parallel_get_threads(void);
+ThreadPool *parallel_pool(void);
+int  parallel_select(int *, int, int, int);
+
+#endif // PARALLEL_SELECT_H
@@ -0,0 +1,339 @@
+/*
+ * ===============================================
+ *     Implementation of Partition Kernels
+ * ===============================================
+ */
+
+#include "PartitionKernels.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define KERNEL_X86 1
+#include <immintrin.h>
+#include <pthread.h>
+#endif
+
+// Number of elements inspected per block by partition_block
+#define BLOCK_SIZE 128
+// Ranges shorter than this are not worth the vector kernels' setup
+#define VECTOR_MIN 64
+
+// Branchless Lomuto partition of the range [left, right] around "pivot", which is not part of the range
+// Every element is swapped unconditionally and the boundary only advances by the result of the comparison
+// Returns the index of the first value greater than the pivot
+static int partition_lomuto(int arr[], int left, int right, int pivot) {
+
+    int i = left;
+
+    for (int j = left; j <= right; j++) {
+        int value = arr[j];
+        arr[j] = arr[i];
+        arr[i] = value;
+        i += (value <= pivot);
+    }
+    return i;
+}
+
+// BlockQuicksort-style partition
+// Blocks of BLOCK_SIZE elements are scanned from both ends and the offsets of misplaced values
+// are written unconditionally (only the counters depend on the comparisons), then swapped in pairs
+// The middle left over by the blocks is finished by the branchless Lomuto loop
+int partition_block(int arr[], int left, int right) {
+
+    int pivot = arr[right];
+    int l = left;
+    int r = right - 1;
+    unsigned char offL[BLOCK_SIZE];
+    unsigned char offR[BLOCK_SIZE];
+    int startL = 0, numL = 0;
+    int startR = 0, numR = 0;
+
+    while (r - l + 1 > 2 * BLOCK_SIZE) {
+
+        if (numL == 0) {
+            startL = 0;
+            for (int i = 0; i < BLOCK_SIZE; i++) {
+                offL[numL] = (unsigned char)i;
+                numL += (arr[l + i] > pivot);
+            }
+        }
+        if (numR == 0) {
+            startR = 0;
+            for (int i = 0; i < BLOCK_SIZE; i++) {
+                offR[numR] = (unsigned char)i;
+                numR += (arr[r - i] <= pivot);
+            }
+        }
+
+        int num = (numL < numR) ? numL : numR;
+        for (int j = 0; j < num; j++) {
+            quick_swap(&arr[l + offL[startL + j]], &arr[r - offR[startR + j]]);
+        }
+
+        numL -= num; numR -= num;
+        startL += num; startR += num;
+        if (numL == 0)
+            l += BLOCK_SIZE;
+        if (numR == 0)
+            r -= BLOCK_SIZE;
+    }
+
+    int i = partition_lomuto(arr, l, r, pivot);
+    quick_swap(&arr[i], &arr[right]);
+
+    return i;
+}
+
+#ifdef KERNEL_X86
+
+// For every 8-bit mask of "value <= pivot" lanes, the lane permutation that moves
+// the selected lanes first (in order) and the other lanes last
+// Built once, even when several benchmark workers reach the kernel at the same time
+static int permTable[256][8];
+static pthread_once_t permTableOnce = PTHREAD_ONCE_INIT;
+
+static void partition_init_table(void) {
+
+    for (int mask = 0; mask < 256; mask++) {
+        int next = 0;
+        for (int lane = 0; lane < 8; lane++) {
+            if (mask & (1 << lane))
+                permTable[mask][next++] = lane;
+        }
+        for (int lane = 0; lane < 8; lane++) {
+            if (!(mask & (1 << lane)))
+                permTable[mask][next++] = lane;
+        }
+    }
+}
+
+// Places the values of a vector : those <= pivot at base[*lw], the others right before base[*rw]
+// Both stores write the whole vector, so at least 8 free slots are needed on each side
+__attribute__((target("avx2")))
+static inline void partition_store_avx2(int *base, __m256i v, __m256i pv, int *lw, int *rw) {
+
+    __m256i gt = _mm256_cmpgt_epi32(v, pv);
+    int mask = ~_mm256_movemask_ps(_mm256_castsi256_ps(gt)) & 0xFF;
+    __m256i perm = _mm256_loadu_si256((__m256i *)permTable[mask]);
+    __m256i packed = _mm256_permutevar8x32_epi32(v, perm);
+    int count = __builtin_popcount(mask);
+
+    _mm256_storeu_si256((__m256i *)(base + *lw), packed);
+    _mm256_storeu_si256((__m256i *)(base + *rw - 8), packed);
+    *lw += count;
+    *rw -= 8 - count;
+}
+
+// In-place AVX2 partition
+// The first and last vectors are kept in registers, which frees 8 slots at each end of the range
+// Each step reads the next vector from the side with less free space, so both sides always have
+// room for a full store, then the values still unread and the saved vectors are placed one by one
+__attribute__((target("avx2")))
+int partition_avx2(int arr[], int left, int right) {
+
+    int n = right - left;
+    if (n < VECTOR_MIN)
+        return partition_block(arr, left, right);
+    pthread_once(&permTableOnce, partition_init_table);
+
+    int pivot = arr[right];
+    int *base = arr + left;
+    __m256i pv = _mm256_set1_epi32(pivot);
+    __m256i first = _mm256_loadu_si256((__m256i *)base);
+    __m256i last = _mm256_loadu_si256((__m256i *)(base + n - 8));
+    // [lr, rr) is still unread, [lw, lr) and [rr, rw) are free
+    int lw = 0, lr = 8;
+    int rr = n - 8, rw = n;
+
+    while (rr - lr >= 8) {
+        __m256i v;
+        if (lr - lw <= rw - rr) {
+            v = _mm256_loadu_si256((__m256i *)(base + lr));
+            lr += 8;
+        } else {
+            rr -= 8;
+            v = _mm256_loadu_si256((__m256i *)(base + rr));
+        }
+        partition_store_avx2(base, v, pv, &lw, &rw);
+    }
+
+    int rest[24];
+    int restLen = rr - lr;
+    memcpy(rest, base + lr, restLen * sizeof(int));
+    _mm256_storeu_si256((__m256i *)(rest + restLen), first);
+    _mm256_storeu_si256((__m256i *)(rest + restLen + 8), last);
+    restLen += 16;
+    for (int i = 0; i < restLen; i++) {
+        if (rest[i] <= pivot)
+            base[lw++] = rest[i];
+        else
+            base[--rw] = rest[i];
+    }
+
+    quick_swap(&base[lw], &arr[right]);
+    return left + lw;
+}
+
+// In-place AVX-512 partition, same scheme as partition_avx2 with 16 lanes
+// Compress-stores only write the selected lanes, so no permutation table is needed
+__attribute__((target("avx512f")))
+int partition_avx512(int arr[], int left, int right) {
+
+    int n = right - left;
+    if (n < VECTOR_MIN)
+        return partition_block(arr, left, right);
+
+    int pivot = arr[right];
+    int *base = arr + left;
+    __m512i pv = _mm512_set1_epi32(pivot);
+    __m512i first = _mm512_loadu_si512(base);
+    __m512i last = _mm512_loadu_si512(base + n - 16);
+    int lw = 0, lr = 16;
+    int rr = n - 16, rw = n;
+
+    while (rr - lr >= 16) {
+        __m512i v;
+        if (lr - lw <= rw - rr) {
+            v = _mm512_loadu_si512(base + lr);
+            lr += 16;
+        } else {
+            rr -= 16;
+            v = _mm512_loadu_si512(base + rr);
+        }
+        __mmask16 le = _mm512_cmple_epi32_mask(v, pv);
+        int count = __builtin_popcount(le);
+        _mm512_mask_compressstoreu_epi32(base + lw, le, v);
+        _mm512_mask_compressstoreu_epi32(base + rw - (16 - count), (__mmask16)~le, v);
+        lw += count;
+        rw -= 16 - count;
+    }
+
+    int rest[48];
+    int restLen = rr - lr;
+    memcpy(rest, base + lr, restLen * sizeof(int));
+    _mm512_storeu_si512(rest + restLen, first);
+    _mm512_storeu_si512(rest + restLen + 16, last);
+    restLen += 32;
+    for (int i = 0; i < restLen; i++) {
+        if (rest[i] <= pivot)
+            base[lw++] = rest[i];
+        else
+            base[--rw] = rest[i];
+    }
+
+    quick_swap(&base[lw], &arr[right]);
+    return left + lw;
+}
+
+#else
+
+// Vector kernels are only built for x86, partition_kernel never hands these out elsewhere
+int partition_avx2(int arr[], int left, int right) {
+
+    return partition_block(arr, left, right);
+}
+
+int partition_avx512(int arr[], int left, int right) {
+
+    return partition_block(arr, left, right);
+}
+
+#endif
+
+// Returns 1 if the given kernel can run on this CPU
+int partition_supported(enum partitionKernel kernel) {
+
+    switch (kernel) {
+#ifdef KERNEL_X86
+        case kernelAvx2:
+            return __builtin_cpu_supports("avx2") != 0;
+        case kernelAvx512:
+            return __builtin_cpu_supports("avx512f") != 0;
+#else
+        case kernelAvx2:
+        case kernelAvx512:
+            return 0;
+#endif
+        default:
+            return 1;
+    }
+}
+
+// Returns the requested kernel, or the fastest supported one below it if the CPU lacks the instructions
+// kernelBest picks the fastest kernel available at runtime
+partition_fn partition_kernel(enum partitionKernel kernel) {
+
+    if (kernel == kernelBest)
+        kernel = kernelAvx512;
+    if (kernel == kernelAvx512 && !partition_supported(kernelAvx512))
+        kernel = kernelAvx2;
+    if (kernel == kernelAvx2 && !partition_supported(kernelAvx2))
+        kernel = kernelBlock;
+
+    switch (kernel) {
+        case kernelAvx512:
+            return partition_avx512;
+        case kernelAvx2:
+            return partition_avx2;
+        case kernelBlock:
+            return partition_block;
+        default:
+            return quick_partition;
+    }
+}
+
+/*
+ * ===============================================
+ *        Selection on top of the kernels
+ * ===============================================
+ */
+
+// intro_rec's loop with the two-way partition steps performed by the given kernel
+// Returns the kth smallest element in the array
+int kernel_rec(int arr[], int left, int right, int k, partition_fn partition) {
+
+    return intro_loop(arr, left, right, k, partition);
+}
+
+// Returns the kth smallest value in the given vector using the given kernel
+// Does not modify the vector
+static int kernel_select(int *arr, int arrLen, int kth, int mode, enum partitionKernel kernel) {
+
+    int result = 0;
+    partition_fn partition = partition_kernel(kernel);
+    int *arr_cpy = malloc(arrLen * sizeof(int));
+    memcpy(arr_cpy, (int *)arr, arrLen * sizeof(int));
+
+    if (mode == 0) {
+        result = kernel_rec(arr_cpy, 0, arrLen - 1, kth, partition);
+    }
+
+    free(arr_cpy);
+    return result;
+}
+
+// One entry point per kernel, with the same signature as the other selection algorithms
+// so that each of them can be timed by compute_selection_timings
+int kernel_select_scalar(int *arr, int arrLen, int kth, int mode) {
+
+    return kernel_select(arr, arrLen, kth, mode, kernelScalar);
+}
+
+int kernel_select_block(int *arr, int arrLen, int kth, int mode) {
+
+    return kernel_select(arr, arrLen, kth, mode, kernelBlock);
+}
+
+int kernel_select_avx2(int *arr, int arrLen, int kth, int mode) {
+
+    return kernel_select(arr, arrLen, kth, mode, kernelAvx2);
+}
+
+int kernel_select_avx512(int *arr, int arrLen, int kth, int mode) {
+
+    return kernel_select(arr, arrLen, kth, mode, kernelAvx512);
+}
+
+int kernel_select_best(int *arr, int arrLen, int kth, int mode) {
+
+    return kernel_select(arr, arrLen, kth, mode, kernelBest);
+}
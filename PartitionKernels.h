@@ -0,0 +1,27 @@
+#ifndef PARTITION_KERNELS_H
+#define PARTITION_KERNELS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "QuickSelect.h"
+#include "MedianSelect.h"
+#include "IntroSelect.h"
+
+// Every kernel is a partition_fn (IntroSelect.h), following quick_partition's contract
+enum partitionKernel {kernelScalar = 0, kernelBlock = 1, kernelAvx2 = 2, kernelAvx512 = 3, kernelBest = 4};
+
+int          partition_block(int *, int, int);
+int          partition_avx2(int *, int, int);
+int          partition_avx512(int *, int, int);
+int          partition_supported(enum partitionKernel);
+partition_fn partition_kernel(enum partitionKernel);
+
+int  kernel_rec(int *, int, int, int, partition_fn);
+int  kernel_select_scalar(int *, int, int, int);
+int  kernel_select_block(int *, int, int, int);
+int  kernel_select_avx2(int *, int, int, int);
+int  kernel_select_avx512(int *, int, int, int);
+int  kernel_select_best(int *, int, int, int);
+
+#endif // PARTITION_KERNELS_H
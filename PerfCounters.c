@@ -0,0 +1,123 @@
+/*
+ * ===============================================
+ *    Hardware Performance Counters (Linux)
+ * ===============================================
+ */
+
+#include "PerfCounters.h"
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+static const char *perfNames[PERF_COUNTERS] = {"cycles", "instructions", "branch_misses",
+                                               "l1d_misses", "llc_misses", "dtlb_misses"};
+
+// One file descriptor per counter, -1 when the event cannot be opened
+// (no PMU exposed to a virtual machine, perf_event_paranoid too high, ...)
+// Counters only count the thread that opened them, so each thread has its own
+static _Thread_local int perfFds[PERF_COUNTERS] = {-1, -1, -1, -1, -1, -1};
+static _Thread_local int perfOpened = 0;
+// Value, time enabled and time running of each counter, read by perf_start
+static _Thread_local uint64_t perfStart[PERF_COUNTERS][3];
+
+static uint64_t perf_cache_config(uint64_t cache, uint64_t op, uint64_t result) {
+
+    return cache | (op << 8) | (result << 16);
+}
+
+static int perf_open_event(uint32_t type, uint64_t config) {
+
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    // Lets perf_stop scale the counts when the kernel multiplexes more events than the PMU holds
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+// Opens the counters of the calling thread, each one independently so that a missing event
+// does not disable the others
+// Returns the number of counters available, 0 meaning only time can be measured
+int perf_open(void) {
+
+    if (!perfOpened) {
+        perfFds[perfCycles] = perf_open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+        perfFds[perfInstructions] = perf_open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        perfFds[perfBranchMisses] = perf_open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+        perfFds[perfL1dMisses] = perf_open_event(PERF_TYPE_HW_CACHE,
+                perf_cache_config(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS));
+        perfFds[perfLlcMisses] = perf_open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+        perfFds[perfDtlbMisses] = perf_open_event(PERF_TYPE_HW_CACHE,
+                perf_cache_config(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS));
+        perfOpened = 1;
+    }
+
+    int available = 0;
+    for (int i = 0; i < PERF_COUNTERS; i++) {
+        available += (perfFds[i] >= 0);
+    }
+    return available;
+}
+
+void perf_close(void) {
+
+    for (int i = 0; i < PERF_COUNTERS; i++) {
+        if (perfFds[i] >= 0)
+            close(perfFds[i]);
+        perfFds[i] = -1;
+    }
+    perfOpened = 0;
+}
+
+int perf_available(enum perfCounter counter) {
+
+    return perfFds[counter] >= 0;
+}
+
+const char *perf_counter_name(enum perfCounter counter) {
+
+    return perfNames[counter];
+}
+
+// Reads the counters before enabling them : perf_stop scales by the times enabled and running
+// between its own read and this one, since resetting a counter does not reset its times
+void perf_start(void) {
+
+    for (int i = 0; i < PERF_COUNTERS; i++) {
+        if (perfFds[i] >= 0 && read(perfFds[i], perfStart[i], sizeof(perfStart[i])) != sizeof(perfStart[i]))
+            memset(perfStart[i], 0, sizeof(perfStart[i]));
+    }
+    for (int i = 0; i < PERF_COUNTERS; i++) {
+        if (perfFds[i] >= 0)
+            ioctl(perfFds[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+// Stops the counters and adds the counts since perf_start to counts[]
+// When the kernel multiplexed a counter, its count is scaled by the share of the window it ran
+// Unavailable counters are left untouched
+void perf_stop(double *counts) {
+
+    for (int i = 0; i < PERF_COUNTERS; i++) {
+        if (perfFds[i] >= 0)
+            ioctl(perfFds[i], PERF_EVENT_IOC_DISABLE, 0);
+    }
+    for (int i = 0; i < PERF_COUNTERS; i++) {
+        uint64_t values[3];   // value, time enabled, time running
+        if (perfFds[i] < 0 || read(perfFds[i], values, sizeof(values)) != sizeof(values))
+            continue;
+        uint64_t count = values[0] - perfStart[i][0];
+        uint64_t enabled = values[1] - perfStart[i][1];
+        uint64_t running = values[2] - perfStart[i][2];
+        double scale = (running > 0 && running < enabled) ? (double)enabled / running : 1.0;
+        counts[i] += count * scale;
+    }
+}
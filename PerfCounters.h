@@ -0,0 +1,20 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#define PERF_COUNTERS 6
+
+enum perfCounter {perfCycles, perfInstructions, perfBranchMisses, perfL1dMisses, perfLlcMisses, perfDtlbMisses};
+
+int         perf_open(void);
+void        perf_close(void);
+int         perf_available(enum perfCounter);
+const char *perf_counter_name(enum perfCounter);
+void        perf_start(void);
+void        perf_stop(double *);
+
+#endif // PERF_COUNTERS_H
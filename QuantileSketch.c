@@ -0,0 +1,301 @@
+/*
+ * ===============================================
+ *    Implementation of the KLL Quantile Sketch
+ * ===============================================
+ */
+
+#include "QuantileSketch.h"
+
+#define SKETCH_MIN_K 8
+// Smallest capacity of a level, keeps the low levels from compacting every couple of insertions
+#define SKETCH_MIN_WIDTH 8
+#define SKETCH_INIT_LEVELS 4
+
+static void sketch_update_budget(QuantileSketch *);
+
+// Returns the k giving a normalized rank error of about eps
+int sketch_k_for_error(double eps) {
+
+    int k = (int)ceil(2.0 / eps);
+    return k < SKETCH_MIN_K ? SKETCH_MIN_K : k;
+}
+
+// Returns the k whose sketch fits in about the given number of KB (~3k ints held)
+int sketch_k_for_memory(int kb) {
+
+    int k = (int)((long)kb * 1024 / (3 * sizeof(int)));
+    return k < SKETCH_MIN_K ? SKETCH_MIN_K : k;
+}
+
+void sketch_init(QuantileSketch *sk, int k) {
+
+    sk->k = k < SKETCH_MIN_K ? SKETCH_MIN_K : k;
+    sk->levels = 1;
+    sk->maxLevels = SKETCH_INIT_LEVELS;
+    sk->items = calloc(sk->maxLevels, sizeof(int *));
+    sk->sizes = calloc(sk->maxLevels, sizeof(int));
+    sk->allocated = calloc(sk->maxLevels, sizeof(int));
+    sk->held = 0;
+    sk->n = 0;
+    sk->rng = 0x2545F4914F6CDD1DULL;
+    sketch_update_budget(sk);
+}
+
+void sketch_free(QuantileSketch *sk) {
+
+    for (int h = 0; h < sk->maxLevels; h++) {
+        free(sk->items[h]);
+    }
+    free(sk->items);
+    free(sk->sizes);
+    free(sk->allocated);
+}
+
+// Bytes currently allocated by the sketch
+long sketch_memory_bytes(QuantileSketch *sk) {
+
+    long bytes = sizeof(QuantileSketch) + (long)sk->maxLevels * (sizeof(int *) + 2 * sizeof(int));
+    for (int h = 0; h < sk->levels; h++) {
+        bytes += (long)sk->allocated[h] * sizeof(int);
+    }
+    return bytes;
+}
+
+// Capacity of level h : k for the top level, 2/3 of the level above for the others, at least SKETCH_MIN_WIDTH
+static int sketch_capacity(QuantileSketch *sk, int h) {
+
+    int capacity = (int)ceil(sk->k * pow(2.0 / 3.0, sk->levels - 1 - h));
+    return capacity < SKETCH_MIN_WIDTH ? SKETCH_MIN_WIDTH : capacity;
+}
+
+static void sketch_update_budget(QuantileSketch *sk) {
+
+    sk->budget = 0;
+    for (int h = 0; h < sk->levels; h++) {
+        sk->budget += sketch_capacity(sk, h);
+    }
+}
+
+static void sketch_add_level(QuantileSketch *sk) {
+
+    if (sk->levels == sk->maxLevels) {
+        int maxLevels = sk->maxLevels * 2;
+        sk->items = realloc(sk->items, maxLevels * sizeof(int *));
+        sk->sizes = realloc(sk->sizes, maxLevels * sizeof(int));
+        sk->allocated = realloc(sk->allocated, maxLevels * sizeof(int));
+        for (int h = sk->maxLevels; h < maxLevels; h++) {
+            sk->items[h] = NULL;
+            sk->sizes[h] = 0;
+            sk->allocated[h] = 0;
+        }
+        sk->maxLevels = maxLevels;
+    }
+    sk->levels++;
+    sketch_update_budget(sk);
+}
+
+// Makes room for "count" more values on level h
+static void sketch_reserve(QuantileSketch *sk, int h, int count) {
+
+    int needed = sk->sizes[h] + count;
+    if (needed > sk->allocated[h]) {
+        int allocated = sk->allocated[h] > 0 ? sk->allocated[h] : 2;
+        while (allocated < needed)
+            allocated *= 2;
+        sk->items[h] = realloc(sk->items[h], allocated * sizeof(int));
+        sk->allocated[h] = allocated;
+    }
+}
+
+// Appends "count" values to level h
+static void sketch_append(QuantileSketch *sk, int h, int *values, int count) {
+
+    sketch_reserve(sk, h, count);
+    memcpy(sk->items[h] + sk->sizes[h], values, count * sizeof(int));
+    sk->sizes[h] += count;
+    sk->held += count;
+}
+
+// Merges the sorted run of "count" values into the sorted level h (h >= 1), from the back, in place
+// Every level above 0 is kept sorted this way, so only level 0 ever needs sorting
+static void sketch_append_sorted(QuantileSketch *sk, int h, int *run, int count) {
+
+    sketch_reserve(sk, h, count);
+    int *level = sk->items[h];
+    int i = sk->sizes[h] - 1;
+    int j = count - 1;
+    int w = sk->sizes[h] + count - 1;
+
+    while (j >= 0) {
+        if (i >= 0 && level[i] > run[j])
+            level[w--] = level[i--];
+        else
+            level[w--] = run[j--];
+    }
+    sk->sizes[h] += count;
+    sk->held += count;
+}
+
+static int sketch_compare(const void *a, const void *b) {
+
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+// Sorts level h (if it is level 0) and promotes every other value to level h + 1, starting at a random offset
+// With an odd count, the largest value stays on level h
+static void sketch_compact(QuantileSketch *sk, int h) {
+
+    if (h + 1 == sk->levels)
+        sketch_add_level(sk);
+
+    int size = sk->sizes[h];
+    int *level = sk->items[h];
+    if (h == 0) {
+        if (size <= 32)
+            insertionSort(level, size);
+        else
+            qsort(level, size, sizeof(int), sketch_compare);
+    }
+
+    sk->rng ^= sk->rng << 13;
+    sk->rng ^= sk->rng >> 7;
+    sk->rng ^= sk->rng << 17;
+    int offset = (int)(sk->rng & 1);
+
+    int pairs = size / 2;
+    int promoted = 0;
+    for (int i = 0; i < pairs; i++) {
+        level[promoted++] = level[2 * i + offset];
+    }
+    int kept = size & 1;
+    int last = level[size - 1];
+
+    sk->sizes[h] = 0;
+    sk->held -= size;
+    sketch_append_sorted(sk, h + 1, level, promoted);
+    if (kept) {
+        level[0] = last;
+        sk->sizes[h] = 1;
+        sk->held += 1;
+    }
+}
+
+// Compacts the lowest full levels until the sketch fits its budget again
+static void sketch_compress(QuantileSketch *sk) {
+
+    while (sk->held >= sk->budget) {
+        for (int h = 0; h < sk->levels; h++) {
+            if (sk->sizes[h] >= sketch_capacity(sk, h)) {
+                sketch_compact(sk, h);
+                break;
+            }
+        }
+    }
+}
+
+void sketch_insert(QuantileSketch *sk, int value) {
+
+    sketch_append(sk, 0, &value, 1);
+    sk->n++;
+    if (sk->held >= sk->budget)
+        sketch_compress(sk);
+}
+
+// Inserts the values in blocks : each block fills level 0 up to its capacity at once, then is compressed
+void sketch_insert_batch(QuantileSketch *sk, int *arr, int arrLen) {
+
+    int i = 0;
+    while (i < arrLen) {
+        int room = sketch_capacity(sk, 0) - sk->sizes[0];
+        int count = room < 1 ? 1 : room;
+        if (count > arrLen - i)
+            count = arrLen - i;
+
+        sketch_append(sk, 0, arr + i, count);
+        sk->n += count;
+        i += count;
+        if (sk->held >= sk->budget)
+            sketch_compress(sk);
+    }
+}
+
+// Merges src into dst : levels of equal weight are concatenated, then dst is compressed
+// src is not modified, so per-thread or per-file sketches can be combined in any order
+void sketch_merge(QuantileSketch *dst, QuantileSketch *src) {
+
+    while (dst->levels < src->levels)
+        sketch_add_level(dst);
+    if (src->sizes[0] > 0)
+        sketch_append(dst, 0, src->items[0], src->sizes[0]);
+    for (int h = 1; h < src->levels; h++) {
+        if (src->sizes[h] > 0)
+            sketch_append_sorted(dst, h, src->items[h], src->sizes[h]);
+    }
+    dst->n += src->n;
+    if (dst->held >= dst->budget)
+        sketch_compress(dst);
+}
+
+// Estimated number of inserted values <= x
+long sketch_rank(QuantileSketch *sk, int x) {
+
+    long rank = 0;
+    for (int h = 0; h < sk->levels; h++) {
+        long count = 0;
+        for (int i = 0; i < sk->sizes[h]; i++) {
+            count += (sk->items[h][i] <= x);
+        }
+        rank += count << h;
+    }
+    return rank;
+}
+
+struct _weightedValue {
+    int value;
+    long weight;
+};
+
+static int sketch_compare_weighted(const void *a, const void *b) {
+
+    int x = ((const struct _weightedValue *)a)->value;
+    int y = ((const struct _weightedValue *)b)->value;
+    return (x > y) - (x < y);
+}
+
+// Returns the estimated kth smallest inserted value
+int sketch_select(QuantileSketch *sk, long kth) {
+
+    struct _weightedValue *all = malloc(sk->held * sizeof(struct _weightedValue));
+    int count = 0;
+
+    for (int h = 0; h < sk->levels; h++) {
+        for (int i = 0; i < sk->sizes[h]; i++) {
+            all[count].value = sk->items[h][i];
+            all[count].weight = 1L << h;
+            count++;
+        }
+    }
+    qsort(all, count, sizeof(struct _weightedValue), sketch_compare_weighted);
+
+    int result = count > 0 ? all[count - 1].value : 0;
+    long cumulated = 0;
+    for (int i = 0; i < count; i++) {
+        cumulated += all[i].weight;
+        if (cumulated >= kth) {
+            result = all[i].value;
+            break;
+        }
+    }
+
+    free(all);
+    return result;
+}
+
+// Returns the estimated q-quantile (0 <= q <= 1) of the inserted values
+int sketch_quantile(QuantileSketch *sk, double q) {
+
+    long kth = (long)ceil(q * sk->n);
+    return sketch_select(sk, kth < 1 ? 1 : kth);
+}
@@ -0,0 +1,42 @@
+#ifndef QUANTILE_SKETCH_H
+#define QUANTILE_SKETCH_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "MedianSelect.h"
+
+// KLL quantile sketch
+// Level h holds values standing for 2^h inserted values each; when the sketch outgrows its budget,
+// the lowest full level is sorted and every other value (starting at a random offset) is promoted,
+// halving it. Level capacities shrink geometrically (by 2/3) from the top level, of capacity k,
+// downwards, so the sketch holds about 3k values and answers rank queries within ~2/k * n
+struct _quantileSketch {
+    int k;
+    int levels;
+    int maxLevels;
+    int **items;            // values of each level
+    int *sizes;
+    int *allocated;         // allocated slots of each level
+    int held;               // total number of values held by all the levels
+    int budget;             // sum of the level capacities, compaction starts when held reaches it
+    long n;                 // number of values inserted (merged sketches included)
+    unsigned long long rng;
+}; typedef struct _quantileSketch QuantileSketch;
+
+int  sketch_k_for_error(double);
+int  sketch_k_for_memory(int);
+void sketch_init(QuantileSketch *, int);
+void sketch_free(QuantileSketch *);
+long sketch_memory_bytes(QuantileSketch *);
+
+void sketch_insert(QuantileSketch *, int);
+void sketch_insert_batch(QuantileSketch *, int *, int);
+void sketch_merge(QuantileSketch *, QuantileSketch *);
+
+long sketch_rank(QuantileSketch *, int);
+int  sketch_select(QuantileSketch *, long);
+int  sketch_quantile(QuantileSketch *, double);
+
+#endif // QUANTILE_SKETCH_H
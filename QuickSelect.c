@@ -5,9 +5,11 @@
  */
 
 #include "QuickSelect.h"
+#include "IntroSelect.h"
 
 void quick_swap(int *a, int *b) {
 
+    OP_SWAP();
     int temp = *a;
     *a = *b;
     *b = temp;
@@ -24,6 +26,8 @@ int quick_partition(int arr[], int left, int right) {
     int i = left;
     int j;
 
+    OP_PASS();
+    OP_COMPARE(right - left);
     for (j = left; j < right; j++) {
         if (arr[j] <= pivot){
             quick_swap(&arr[i], &arr[j]);
@@ -36,26 +40,93 @@ int quick_partition(int arr[], int left, int right) {
     return i;
 }
 
+// Three-way (Dutch national flag) version of quick_partition
+// Modifies the array so that [left, *lt) holds the values smaller than the pivot,
+// [*lt, *gt] the values equal to it and (*gt, right] the values greater than it
+
+// The chosen pivot is ALWAYS the rightmost value in the given array
+void quick_partition3(int arr[], int left, int right, int *lt, int *gt) {
+
+    int pivot = arr[right];
+    int l = left;
+    int i = left;
+    int g = right;
+
+    OP_PASS();
+    while (i <= g) {
+        OP_COMPARE(1);
+        if (arr[i] < pivot) {
+            quick_swap(&arr[l], &arr[i]);
+            l++;
+            i++;
+        } else if (arr[i] > pivot) {
+            quick_swap(&arr[i], &arr[g]);
+            g--;
+        } else {
+            i++;
+        }
+    }
+
+    *lt = l;
+    *gt = g;
+}
+
 // Recursively applies partition and itself until the array is partitioned in such a way
 // the index of the pivot is the same as the k value given
 // Returns the kth smallest element in the array
 int quick_rec(int arr[], int left, int right, int k) {
 
+    int result;
+    OP_ENTER();
     int indexOfPivot = quick_partition(arr, left, right);
 
     // if the index of the pivot is the same as k
     if (indexOfPivot == k - 1) {
         // return the value at its position
-        return arr[indexOfPivot];
+        result = arr[indexOfPivot];
         // if the index of the pivot is greater than k
     } else if (indexOfPivot > k - 1) {
         // recursion on the left partition of the array
-        return quick_rec(arr, left, indexOfPivot - 1, k);
+        result = quick_rec(arr, left, indexOfPivot - 1, k);
         // if the index of the pivot is greater than k
     } else {
         // recursion on the right partition of the array
-        return quick_rec(arr, indexOfPivot + 1, right, k);
+        result = quick_rec(arr, indexOfPivot + 1, right, k);
     }
+
+    OP_LEAVE();
+    return result;
+}
+
+// Same as quick_rec with a three-way partition : values equal to the pivot are never
+// partitioned again, and the search stops as soon as k falls among them
+// Unlike quick_rec, the pivot is sampled by intro_pivot (median of three or ninther)
+// and the search narrows in a loop, so sorted and reverse inputs stay linear on average
+// and the stack does not grow with the array
+// Returns the kth smallest element in the array
+int quick_rec3(int arr[], int left, int right, int k) {
+
+    int lt, gt;
+    OP_ENTER();
+
+    while (right > left) {
+        intro_pivot(arr, left, right);
+        quick_partition3(arr, left, right, &lt, &gt);
+
+        // if k falls in the band of values equal to the pivot
+        if (k - 1 >= lt && k - 1 <= gt) {
+            left = right = k - 1;
+            // if k falls among the smaller values
+        } else if (k - 1 < lt) {
+            right = lt - 1;
+            // if k falls among the greater values
+        } else {
+            left = gt + 1;
+        }
+    }
+
+    OP_LEAVE();
+    return arr[k - 1];
 }
 
 // Returns the kth smallest value in the given vector
@@ -73,4 +144,42 @@ int quick_select(int *arr, int arrLen, int kth, int mode){
     free(arr_cpy);
     return result;
 
-}
\ No newline at end of file
+}
+
+// Returns the kth smallest value in the given vector using three-way partitions
+// Does not modify the vector
+int quick_select3(int *arr, int arrLen, int kth, int mode){
+
+    int result = 0;
+    int *arr_cpy = malloc(arrLen * sizeof(int));
+    memcpy(arr_cpy, (int *)arr, arrLen * sizeof(int));
+
+    if (mode == 0) {
+        result = quick_rec3(arr_cpy, 0, arrLen - 1, kth);
+    }
+
+    free(arr_cpy);
+    return result;
+}
+
+// Returns the kth smallest value in the given vector without copying it
+// Modifies the vector: its values are permuted by the partitions
+int quick_select_inplace(int *arr, int arrLen, int kth, int mode){
+
+    int result = 0;
+
+    if (mode == 0) {
+        result = quick_rec(arr, 0, arrLen - 1, kth);
+    }
+
+    return result;
+}
+
+// Returns the kth smallest value in the given vector
+// Does not modify the vector: its values are copied to the caller-owned scratch buffer,
+// which must hold at least arrLen values, so that repeated queries perform no allocation
+int quick_select_scratch(int *arr, int arrLen, int kth, int *scratch){
+
+    memcpy(scratch, (int *)arr, arrLen * sizeof(int));
+    return quick_rec(scratch, 0, arrLen - 1, kth);
+}
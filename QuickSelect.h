@@ -4,10 +4,16 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "OpCounters.h"
 
 void quick_swap(int *, int *);
 int  quick_partition(int *, int, int);
+void quick_partition3(int *, int, int, int *, int *);
 int  quick_rec(int *, int, int, int);
+int  quick_rec3(int *, int, int, int);
 int  quick_select(int *, int, int, int);
+int  quick_select3(int *, int, int, int);
+int  quick_select_inplace(int *, int, int, int);
+int  quick_select_scratch(int *, int, int, int *);
 
 #endif // QUICK_SELECT_H
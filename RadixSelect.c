@@ -0,0 +1,244 @@
+/*
+ * ===============================================
+ * 	 Implementation of Radix Select Function
+ * ===============================================
+ */
+
+#include "RadixSelect.h"
+
+// Bits of key resolved by each histogram pass
+#define RADIX_BITS 8
+#define RADIX_BUCKETS (1 << RADIX_BITS)
+// Candidate sets up to this size are finished by intro_rec
+#define RADIX_SMALL 4096
+// Passes over fewer values run on the calling thread only
+#define RADIX_PARALLEL_MIN (1L << 18)
+
+// Ints are mapped to unsigned keys of the same order by flipping the sign bit
+static inline uint32_t radix_key(int value) {
+
+    return (uint32_t)value ^ 0x80000000u;
+}
+
+static inline int radix_value(uint32_t key) {
+
+    return (int)(key ^ 0x80000000u);
+}
+
+// State shared by the threads during one pass over src
+// Every candidate key lies in [lo, hi]; a pass sorts them into RADIX_BUCKETS buckets
+// by the digit (key - lo) >> shift and moves the bucket holding k to dst
+struct _radixRound {
+    const int *src;
+    long n;
+    int *dst;
+    int nthreads;
+    uint32_t lo, hi;
+    int shift;
+    int bucket;
+    long *counts;                // RADIX_BUCKETS counters per thread
+    uint32_t *ranges;            // minimum and maximum key of each thread's chunk
+};
+
+static void radix_chunk(struct _radixRound *r, int tid, long *begin, long *end) {
+
+    *begin = r->n * tid / r->nthreads;
+    *end = r->n * (tid + 1) / r->nthreads;
+}
+
+// Each thread computes the smallest and largest key of its chunk
+// Branch-free min / max reductions, vectorized by the compiler
+static void radix_range_job(void *ctx, int tid) {
+
+    struct _radixRound *r = ctx;
+    long begin, end;
+    radix_chunk(r, tid, &begin, &end);
+    uint32_t lo = UINT32_MAX, hi = 0;
+
+    for (long i = begin; i < end; i++) {
+        uint32_t key = radix_key(r->src[i]);
+        lo = key < lo ? key : lo;
+        hi = key > hi ? key : hi;
+    }
+    r->ranges[tid * 2] = lo;
+    r->ranges[tid * 2 + 1] = hi;
+}
+
+// Each thread counts the digits of its chunk
+// Four interleaved histograms break the dependency between successive increments of the same
+// counter, which otherwise serializes the loop on runs of equal digits
+static void radix_histogram_job(void *ctx, int tid) {
+
+    struct _radixRound *r = ctx;
+    long begin, end;
+    radix_chunk(r, tid, &begin, &end);
+    uint32_t hist[4][RADIX_BUCKETS];
+    uint32_t lo = r->lo;
+    int shift = r->shift;
+    long i = begin;
+
+    memset(hist, 0, sizeof(hist));
+    for (; i + 4 <= end; i += 4) {
+        hist[0][(radix_key(r->src[i]) - lo) >> shift]++;
+        hist[1][(radix_key(r->src[i + 1]) - lo) >> shift]++;
+        hist[2][(radix_key(r->src[i + 2]) - lo) >> shift]++;
+        hist[3][(radix_key(r->src[i + 3]) - lo) >> shift]++;
+    }
+    for (; i < end; i++) {
+        hist[0][(radix_key(r->src[i]) - lo) >> shift]++;
+    }
+
+    long *counts = r->counts + (long)tid * RADIX_BUCKETS;
+    for (int b = 0; b < RADIX_BUCKETS; b++) {
+        counts[b] = (long)hist[0][b] + hist[1][b] + hist[2][b] + hist[3][b];
+    }
+}
+
+// Each thread copies the values of its chunk that fall in the chosen bucket at its own offset in dst
+// The offset is the sum of the bucket's counts of the previous threads
+static void radix_gather_job(void *ctx, int tid) {
+
+    struct _radixRound *r = ctx;
+    long begin, end;
+    radix_chunk(r, tid, &begin, &end);
+    long offset = 0;
+    for (int t = 0; t < tid; t++) {
+        offset += r->counts[(long)t * RADIX_BUCKETS + r->bucket];
+    }
+    int *out = r->dst + offset;
+    uint32_t lo = r->lo;
+    int shift = r->shift;
+    uint32_t bucket = (uint32_t)r->bucket;
+
+    for (long i = begin; i < end; i++) {
+        int value = r->src[i];
+        if (((radix_key(value) - lo) >> shift) == bucket)
+            *out++ = value;
+    }
+}
+
+// Runs job on every thread of the shared pool, or on the calling thread alone for small passes
+static void radix_run(struct _radixRound *r, ThreadPool *pool, void (*job)(void *, int)) {
+
+    if (pool != NULL && r->n >= RADIX_PARALLEL_MIN) {
+        r->nthreads = pool->nthreads;
+        pool_run(pool, job, r);
+    } else {
+        r->nthreads = 1;
+        job(r, 0);
+    }
+}
+
+// Number of bits needed to write x
+static int radix_width(uint32_t x) {
+
+    return x == 0 ? 0 : 32 - __builtin_clz(x);
+}
+
+// Returns the kth smallest value in the given vector
+// MSD radix selection on keys with a flipped sign bit : a first pass finds the range of the keys,
+// then each pass counts the next RADIX_BITS bits below those all candidates share, keeps the
+// bucket holding k and moves its values to a scratch buffer, so every key is compared to nothing
+// Digits are taken relative to the smallest candidate key rather than at fixed byte boundaries,
+// so that narrow ranges, like the [-n/2, n/2] values of main, need no pass over empty high bytes
+// Passes over large candidate sets are split between the threads of the shared pool;
+// once RADIX_SMALL candidates are left, intro_rec finishes in the scratch buffer
+// Does not modify the vector; mode 1 does nothing, as radix_select never copies the whole vector
+int radix_select(int *arr, int arrLen, int kth, int mode){
+
+    if (mode != 0)
+        return 0;
+
+    ThreadPool *pool = parallel_get_threads() > 1 && arrLen >= RADIX_PARALLEL_MIN ? parallel_pool() : NULL;
+    int nthreads = pool != NULL ? pool->nthreads : 1;
+    struct _radixRound r;
+    long k = kth;
+    int *scratch = NULL;
+    int *spare = NULL;
+    int result;
+
+    r.src = arr;
+    r.n = arrLen;
+    r.counts = malloc((long)nthreads * RADIX_BUCKETS * sizeof(long));
+    r.ranges = malloc(nthreads * 2 * sizeof(uint32_t));
+
+    radix_run(&r, pool, radix_range_job);
+    r.lo = r.ranges[0];
+    r.hi = r.ranges[1];
+    for (int t = 1; t < r.nthreads; t++) {
+        r.lo = r.ranges[t * 2] < r.lo ? r.ranges[t * 2] : r.lo;
+        r.hi = r.ranges[t * 2 + 1] > r.hi ? r.ranges[t * 2 + 1] : r.hi;
+    }
+
+    while (1) {
+
+        // Every candidate is equal : k is found
+        if (r.lo == r.hi) {
+            result = radix_value(r.lo);
+            break;
+        }
+        if (r.n <= RADIX_SMALL) {
+            // intro_rec works in place : the vector itself is only read, so copy it first if no pass ran
+            if (scratch == NULL) {
+                scratch = malloc(r.n * sizeof(int));
+                memcpy(scratch, r.src, r.n * sizeof(int));
+            }
+            result = intro_rec(scratch, 0, (int)r.n - 1, (int)k);
+            break;
+        }
+
+        int width = radix_width(r.hi - r.lo);
+        r.shift = width > RADIX_BITS ? width - RADIX_BITS : 0;
+        radix_run(&r, pool, radix_histogram_job);
+
+        // Finds the bucket holding k and the rank of k inside it
+        long bucketLen = 0;
+        for (r.bucket = 0; r.bucket < RADIX_BUCKETS; r.bucket++) {
+            bucketLen = 0;
+            for (int t = 0; t < r.nthreads; t++) {
+                bucketLen += r.counts[(long)t * RADIX_BUCKETS + r.bucket];
+            }
+            if (k <= bucketLen)
+                break;
+            k -= bucketLen;
+        }
+
+        // The bucket covers the keys lo + bucket << shift ... lo + (bucket + 1) << shift - 1
+        uint32_t bucketLo = r.lo + ((uint32_t)r.bucket << r.shift);
+        uint32_t bucketHi = bucketLo + (((uint32_t)1 << r.shift) - 1);
+        if (bucketHi < bucketLo || bucketHi > r.hi)
+            bucketHi = r.hi;
+
+        // Every candidate fell in one bucket : narrow the range without moving anything
+        if (bucketLen == r.n) {
+            r.lo = bucketLo;
+            r.hi = bucketHi;
+            continue;
+        }
+
+        // The first bucket moves to a buffer of its size, the following ones alternate between
+        // that buffer and a spare of the same size
+        if (scratch == NULL) {
+            scratch = malloc(bucketLen * sizeof(int));
+            r.dst = scratch;
+        } else {
+            if (spare == NULL)
+                spare = malloc(r.n * sizeof(int));
+            r.dst = spare;
+            spare = scratch;
+            scratch = r.dst;
+        }
+        radix_run(&r, pool, radix_gather_job);
+
+        r.src = scratch;
+        r.n = bucketLen;
+        r.lo = bucketLo;
+        r.hi = bucketHi;
+    }
+
+    free(scratch);
+    free(spare);
+    free(r.counts);
+    free(r.ranges);
+    return result;
+}
@@ -0,0 +1,12 @@
+#ifndef RADIX_SELECT_H
+#define RADIX_SELECT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "ParallelSelect.h"
+
+int radix_select(int *, int, int, int);
+
+#endif // RADIX_SELECT_H
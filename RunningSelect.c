@@ -0,0 +1,171 @@
+/*
+ * ===============================================
+ *   Implementation of Running (Sliding) Select
+ * ===============================================
+ */
+
+#include "RunningSelect.h"
+
+// Initializes an empty window of the given width, tracking its kth smallest value
+void running_init(RunningSelect *rs, int window, int kth) {
+
+    heap_init(&rs->low, maxHeap);
+    heap_init(&rs->high, minHeap);
+    rs->side = malloc(window);
+    rs->head = 0;
+    rs->next = 0;
+    rs->window = window;
+    rs->kth = kth;
+    rs->lowCount = 0;
+    rs->highCount = 0;
+    rs->evictions = 0;
+}
+
+void running_free(RunningSelect *rs) {
+
+    free(rs->low.data);
+    free(rs->high.data);
+    free(rs->side);
+}
+
+int running_size(RunningSelect *rs) {
+
+    return (int)(rs->next - rs->head);
+}
+
+// Returns 1 if the node still belongs to the window
+static int running_alive(RunningSelect *rs, Node n) {
+
+    return (unsigned int)n.index - rs->head < rs->next - rs->head;
+}
+
+// Removes evicted values sitting at the root of the heap
+static void running_prune(RunningSelect *rs, Heap *hp) {
+
+    while (heap_size(hp) > 0 && !running_alive(rs, heap_get_root(hp)))
+        heap_extract(hp);
+}
+
+// Drops every evicted value from the heap and heapifies it again
+static void running_compact(RunningSelect *rs, Heap *hp) {
+
+    int size = 0;
+    for (int i = 0; i < heap_size(hp); i++) {
+        if (running_alive(rs, hp->data[i]))
+            hp->data[size++] = hp->data[i];
+    }
+    hp->size = size;
+    for (int i = (size / 2) - 1; i >= 0; --i) {
+        heap_Heapify_down(hp, i);
+    }
+}
+
+// Moves the root of "from" to "to", recording the new side of the value
+static void running_move(RunningSelect *rs, Heap *from, Heap *to, char side) {
+
+    running_prune(rs, from);
+    Node n = heap_get_root(from);
+    heap_extract(from);
+    heap_insert(to, n);
+    rs->side[(unsigned int)n.index % rs->window] = side;
+}
+
+// Restores "low" to the kth smallest values of the window
+static void running_balance(RunningSelect *rs) {
+
+    while (rs->lowCount > rs->kth) {
+        running_move(rs, &rs->low, &rs->high, 1);
+        rs->lowCount--;
+        rs->highCount++;
+    }
+    while (rs->lowCount < rs->kth && rs->highCount > 0) {
+        running_move(rs, &rs->high, &rs->low, 0);
+        rs->highCount--;
+        rs->lowCount++;
+    }
+}
+
+// Adds a value to the window, evicting the oldest one first if the window is full
+// O(log w) amortized
+void running_push(RunningSelect *rs, int value) {
+
+    if (running_size(rs) == rs->window)
+        running_evict(rs);
+
+    Node n;
+    n.value = value;
+    n.index = (int)rs->next;
+    char side = 0;
+
+    running_prune(rs, &rs->low);
+    if (rs->lowCount > 0 && value >= heap_get_root(&rs->low).value)
+        side = 1;
+
+    if (side == 0) {
+        heap_insert(&rs->low, n);
+        rs->lowCount++;
+    } else {
+        heap_insert(&rs->high, n);
+        rs->highCount++;
+    }
+    rs->side[rs->next % rs->window] = side;
+    rs->next++;
+
+    running_balance(rs);
+}
+
+// Removes the oldest value of the window
+// The value is only marked as evicted, the heaps are compacted once every "window" evictions
+// so that they never hold more than twice the window
+void running_evict(RunningSelect *rs) {
+
+    if (running_size(rs) == 0)
+        return;
+
+    if (rs->side[rs->head % rs->window] == 0)
+        rs->lowCount--;
+    else
+        rs->highCount--;
+    rs->head++;
+
+    if (++rs->evictions >= rs->window) {
+        running_compact(rs, &rs->low);
+        running_compact(rs, &rs->high);
+        rs->evictions = 0;
+    }
+
+    running_balance(rs);
+}
+
+// Sets *result to the kth smallest value of the window
+// Returns 0 if the window holds fewer than k values
+int running_query(RunningSelect *rs, int *result) {
+
+    if (rs->lowCount < rs->kth)
+        return 0;
+
+    running_prune(rs, &rs->low);
+    *result = heap_get_root(&rs->low).value;
+    return 1;
+}
+
+// Batch driver : writes the kth smallest value of every window of the given width to out
+// out must hold arrLen - window + 1 values
+// Returns 0, writing nothing, unless 1 <= kth <= window : every window could not hold k values
+int running_select_windows(int *arr, int arrLen, int window, int kth, int *out) {
+
+    if (kth < 1 || kth > window)
+        return 0;
+
+    RunningSelect rs;
+    running_init(&rs, window, kth);
+
+    for (int i = 0; i < arrLen; i++) {
+        running_push(&rs, arr[i]);
+        if (i >= window - 1)
+            running_query(&rs, &out[i - window + 1]);
+    }
+
+    running_free(&rs);
+    return 1;
+}
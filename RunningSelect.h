@@ -0,0 +1,33 @@
+#ifndef RUNNING_SELECT_H
+#define RUNNING_SELECT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "HeapSelect.h"
+
+// Running kth smallest over a sliding window, built on two heaps with lazy deletion :
+// "low" (max-heap) holds the kth smallest values of the window, "high" (min-heap) the others
+// Node.index holds the sequence number of each value, evicted values stay in the heaps
+// until they reach a root or the heaps are compacted
+struct _runningSelect {
+    Heap low;
+    Heap high;
+    char *side;             // heap holding each value of the window (0 : low, 1 : high), by sequence % window
+    unsigned int head;      // sequence number of the oldest value of the window
+    unsigned int next;      // sequence number of the next pushed value
+    int window;
+    int kth;
+    int lowCount;           // values of the window held by each heap
+    int highCount;
+    int evictions;          // since the last compaction
+}; typedef struct _runningSelect RunningSelect;
+
+void running_init(RunningSelect *, int, int);
+void running_free(RunningSelect *);
+int  running_size(RunningSelect *);
+void running_push(RunningSelect *, int);
+void running_evict(RunningSelect *);
+int  running_query(RunningSelect *, int *);
+int  running_select_windows(int *, int, int, int, int *);
+
+#endif // RUNNING_SELECT_H
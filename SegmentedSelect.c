@@ -0,0 +1,205 @@
+/*
+ * ===============================================
+ *   Segmented Selection over Back-to-Back Groups
+ * ===============================================
+ */
+
+#include "SegmentedSelect.h"
+#include <math.h>
+
+// Values a worker takes from its own queue at once, at least one segment
+#define SEGMENT_GRAIN 16384
+// Inputs with fewer values are processed by the calling thread only
+#define SEGMENT_PARALLEL_MIN (1L << 18)
+
+// Queue of segments [begin, end) owned by a worker : the owner takes from the front,
+// thieves take the back half
+struct _segmentQueue {
+    pthread_mutex_t lock;
+    int begin;
+    int end;
+    char padding[64];           // keeps the queues of two workers on different cache lines
+};
+
+struct _segmentJob {
+    const int *values;
+    const long *offsets;
+    int segments;
+    const int *ks;              // rank of each segment, NULL to use quantile
+    double quantile;
+    int *out;
+    int nthreads;
+    struct _segmentQueue *queues;
+};
+
+// Rank of a segment of length len : ks[s] if given, otherwise the nearest-rank quantile
+static int segment_rank(struct _segmentJob *job, int s, long len) {
+
+    long k = job->ks != NULL ? job->ks[s] : (long)ceil(job->quantile * len);
+    if (k < 1)
+        k = 1;
+    if (k > len)
+        k = len;
+    return (int)k;
+}
+
+// Selects the rank of one segment in the worker's scratch buffer, grown when needed
+static void segment_select_one(struct _segmentJob *job, int s, int **scratch, long *scratchLen) {
+
+    long begin = job->offsets[s];
+    long len = job->offsets[s + 1] - begin;
+
+    if (len <= 0) {
+        job->out[s] = 0;
+        return;
+    }
+    if (len > *scratchLen) {
+        free(*scratch);
+        *scratch = malloc(len * sizeof(int));
+        *scratchLen = len;
+    }
+
+    int k = segment_rank(job, s, len);
+    memcpy(*scratch, job->values + begin, len * sizeof(int));
+    if (len <= SEGMENT_SMALL) {
+        insertionSort(*scratch, (int)len);
+        job->out[s] = (*scratch)[k - 1];
+    } else {
+        job->out[s] = intro_rec(*scratch, 0, (int)len - 1, k);
+    }
+}
+
+// Takes segments from the front of the queue until about SEGMENT_GRAIN values are collected
+// Returns 0 if the queue is empty
+static int segment_take(struct _segmentJob *job, struct _segmentQueue *q, int *begin, int *end) {
+
+    pthread_mutex_lock(&q->lock);
+    int first = q->begin;
+    int last = first;
+    long taken = 0;
+    while (last < q->end && (last == first || taken < SEGMENT_GRAIN)) {
+        taken += job->offsets[last + 1] - job->offsets[last];
+        last++;
+    }
+    q->begin = last;
+    pthread_mutex_unlock(&q->lock);
+
+    *begin = first;
+    *end = last;
+    return last > first;
+}
+
+// Moves the back half of the fullest other queue to the thief's queue
+// Returns 0 when every queue is empty
+static int segment_steal(struct _segmentJob *job, int tid) {
+
+    int victim = -1;
+    int most = 0;
+    for (int t = 0; t < job->nthreads; t++) {
+        pthread_mutex_lock(&job->queues[t].lock);
+        int left = job->queues[t].end - job->queues[t].begin;
+        pthread_mutex_unlock(&job->queues[t].lock);
+        if (t != tid && left > most) {
+            most = left;
+            victim = t;
+        }
+    }
+    if (victim < 0)
+        return 0;
+
+    struct _segmentQueue *q = &job->queues[victim];
+    pthread_mutex_lock(&q->lock);
+    int left = q->end - q->begin;
+    int stolenBegin = q->end - (left + 1) / 2;
+    int stolenEnd = q->end;
+    q->end = stolenBegin;
+    pthread_mutex_unlock(&q->lock);
+
+    // The victim may have emptied its queue meanwhile : look again
+    if (stolenEnd <= stolenBegin)
+        return 1;
+
+    struct _segmentQueue *own = &job->queues[tid];
+    pthread_mutex_lock(&own->lock);
+    own->begin = stolenBegin;
+    own->end = stolenEnd;
+    pthread_mutex_unlock(&own->lock);
+    return 1;
+}
+
+static void segment_job(void *ctx, int tid) {
+
+    struct _segmentJob *job = ctx;
+    int *scratch = NULL;
+    long scratchLen = 0;
+    int begin, end;
+
+    while (1) {
+        while (segment_take(job, &job->queues[tid], &begin, &end)) {
+            for (int s = begin; s < end; s++) {
+                segment_select_one(job, s, &scratch, &scratchLen);
+            }
+        }
+        if (!segment_steal(job, tid))
+            break;
+    }
+    free(scratch);
+}
+
+static void segmented_run(struct _segmentJob *job) {
+
+    long total = job->offsets[job->segments] - job->offsets[0];
+
+    if (total < SEGMENT_PARALLEL_MIN || parallel_get_threads() == 1) {
+        struct _segmentQueue queue;
+        pthread_mutex_init(&queue.lock, NULL);
+        queue.begin = 0;
+        queue.end = job->segments;
+        job->nthreads = 1;
+        job->queues = &queue;
+        segment_job(job, 0);
+        pthread_mutex_destroy(&queue.lock);
+        return;
+    }
+
+    ThreadPool *pool = parallel_pool();
+    job->nthreads = pool->nthreads;
+    job->queues = malloc(job->nthreads * sizeof(struct _segmentQueue));
+
+    // Initial queues hold about the same number of values each
+    int s = 0;
+    for (int t = 0; t < job->nthreads; t++) {
+        long target = job->offsets[0] + total * (t + 1) / job->nthreads;
+        pthread_mutex_init(&job->queues[t].lock, NULL);
+        job->queues[t].begin = s;
+        while (s < job->segments && (t == job->nthreads - 1 || job->offsets[s + 1] <= target)) {
+            s++;
+        }
+        job->queues[t].end = s;
+    }
+
+    pool_run(pool, segment_job, job);
+
+    for (int t = 0; t < job->nthreads; t++) {
+        pthread_mutex_destroy(&job->queues[t].lock);
+    }
+    free(job->queues);
+}
+
+// For each of the given segments, writes the ks[s]-th smallest value of segment s to out[s]
+// Segment s holds values[offsets[s]] to values[offsets[s + 1] - 1], so offsets has segments + 1 entries
+// Ranks are clamped to the segment's length; empty segments give 0
+// Does not modify the values
+void segmented_select(const int *values, const long *offsets, int segments, const int *ks, int *out) {
+
+    struct _segmentJob job = {values, offsets, segments, ks, 0, out, 1, NULL};
+    segmented_run(&job);
+}
+
+// Same as segmented_select with the same quantile for every segment, as a nearest rank :
+// k = ceil(quantile * length), e.g. the p99 of each segment for quantile = 0.99
+void segmented_select_quantile(const int *values, const long *offsets, int segments, double quantile, int *out) {
+
+    struct _segmentJob job = {values, offsets, segments, NULL, quantile, out, 1, NULL};
+    segmented_run(&job);
+}
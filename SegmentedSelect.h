@@ -0,0 +1,16 @@
+#ifndef SEGMENTED_SELECT_H
+#define SEGMENTED_SELECT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "IntroSelect.h"
+#include "ParallelSelect.h"
+
+// Segments up to this length are sorted with insertionSort instead of being partitioned
+#define SEGMENT_SMALL 16
+
+void segmented_select(const int *, const long *, int, const int *, int *);
+void segmented_select_quantile(const int *, const long *, int, double, int *);
+
+#endif // SEGMENTED_SELECT_H
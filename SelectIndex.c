@@ -0,0 +1,157 @@
+/*
+ * ===============================================
+ *    Selection Index for Repeated Rank Queries
+ * ===============================================
+ */
+
+#include "SelectIndex.h"
+
+// Ranges up to this size are sorted and settled at once, as in intro_rec
+#define INDEX_SMALL 16
+
+static int index_is_settled(const SelectIndex *idx, int pos) {
+
+    return (idx->settled[pos >> 6] >> (pos & 63)) & 1;
+}
+
+// Marks the positions [from, to] as settled
+static void index_settle(SelectIndex *idx, int from, int to) {
+
+    for (int pos = from; pos <= to; pos++) {
+        if (!index_is_settled(idx, pos)) {
+            idx->settled[pos >> 6] |= (uint64_t)1 << (pos & 63);
+            idx->settledCount++;
+        }
+    }
+}
+
+// Returns the closest settled position before pos, -1 if there is none
+static int index_settled_before(const SelectIndex *idx, int pos) {
+
+    int word = pos >> 6;
+    uint64_t bits = idx->settled[word] & (((uint64_t)1 << (pos & 63)) - 1);
+
+    while (bits == 0) {
+        if (--word < 0)
+            return -1;
+        bits = idx->settled[word];
+    }
+    return word * 64 + 63 - __builtin_clzll(bits);
+}
+
+// Returns the closest settled position after pos, len if there is none
+static int index_settled_after(const SelectIndex *idx, int pos) {
+
+    int words = (idx->len + 63) / 64;
+    int word = pos >> 6;
+    uint64_t bits = (pos & 63) == 63 ? 0 : idx->settled[word] & (~(uint64_t)0 << ((pos & 63) + 1));
+
+    while (bits == 0) {
+        if (++word >= words)
+            return idx->len;
+        bits = idx->settled[word];
+    }
+    return word * 64 + __builtin_ctzll(bits);
+}
+
+// Copies the array into the index, reusing its buffers when they are large enough
+void select_index_reset(SelectIndex *idx, const int *arr, int arrLen) {
+
+    if (arrLen > idx->capacity) {
+        free(idx->data);
+        free(idx->settled);
+        idx->capacity = arrLen;
+        idx->data = malloc(arrLen * sizeof(int));
+        idx->settled = malloc(((arrLen + 63) / 64) * sizeof(uint64_t));
+    }
+    idx->len = arrLen;
+    memcpy(idx->data, arr, arrLen * sizeof(int));
+    select_index_invalidate(idx);
+}
+
+// Builds an index over a copy of the array, nothing settled yet
+void select_index_init(SelectIndex *idx, const int *arr, int arrLen) {
+
+    idx->data = NULL;
+    idx->settled = NULL;
+    idx->capacity = 0;
+    idx->len = 0;
+    idx->settledCount = 0;
+    select_index_reset(idx, arr, arrLen);
+}
+
+// Forgets every settled position, e.g. after the index's data was modified in place
+// The data is kept as is : the next queries partition it from scratch
+// If the source array changed, select_index_reset copies it again instead
+void select_index_invalidate(SelectIndex *idx) {
+
+    if (idx->settled != NULL)
+        memset(idx->settled, 0, ((idx->len + 63) / 64) * sizeof(uint64_t));
+    idx->settledCount = 0;
+}
+
+void select_index_free(SelectIndex *idx) {
+
+    free(idx->data);
+    free(idx->settled);
+    idx->data = NULL;
+    idx->settled = NULL;
+    idx->capacity = 0;
+    idx->len = 0;
+    idx->settledCount = 0;
+}
+
+// Number of positions whose value is final : select_index_kth answers those in O(1)
+int select_index_settled(const SelectIndex *idx) {
+
+    return idx->settledCount;
+}
+
+// Returns the kth smallest value of the indexed array
+// Partitions only between the settled positions around k - 1 with intro_step, like intro_rec,
+// and settles every pivot (or band of values equal to it) it places on the way,
+// so that each query narrows the brackets of the following ones
+int select_index_kth(SelectIndex *idx, int kth) {
+
+    int pos = kth - 1;
+
+    if (index_is_settled(idx, pos))
+        return idx->data[pos];
+
+    int *arr = idx->data;
+    int left = index_settled_before(idx, pos) + 1;
+    int right = index_settled_after(idx, pos) - 1;
+    int stalls = 0;
+
+    while (right > left) {
+
+        int len = right - left + 1;
+        int lt, gt;
+
+        if (len <= INDEX_SMALL) {
+            insertionSort(arr + left, len);
+            index_settle(idx, left, right);
+            return arr[pos];
+        }
+
+        intro_step(arr, left, right, stalls, quick_partition, &lt, &gt);
+        index_settle(idx, lt, gt);
+
+        // if k falls in the band of values equal to the pivot
+        if (pos >= lt && pos <= gt) {
+            return arr[pos];
+            // if k falls among the smaller values
+        } else if (pos < lt) {
+            right = lt - 1;
+            // if k falls among the greater values
+        } else {
+            left = gt + 1;
+        }
+
+        // Tracks how far the partition shrank the active range
+        stalls = intro_stalls(stalls, len, right - left + 1);
+    }
+
+    index_settle(idx, left, left);
+    return arr[left];
+}
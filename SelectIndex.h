@@ -0,0 +1,29 @@
+#ifndef SELECT_INDEX_H
+#define SELECT_INDEX_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "IntroSelect.h"
+
+// Copy of an array kept partially partitioned across rank queries
+// A set bit in settled marks a position holding its final sorted value, every value
+// before it being smaller or equal and every value after it greater or equal
+// Each query only partitions between the settled positions around its rank
+struct _selectIndex {
+    int *data;
+    int len;
+    int capacity;
+    uint64_t *settled;      // one bit per position of data
+    int settledCount;
+}; typedef struct _selectIndex SelectIndex;
+
+void select_index_init(SelectIndex *, const int *, int);
+void select_index_reset(SelectIndex *, const int *, int);
+void select_index_invalidate(SelectIndex *);
+void select_index_free(SelectIndex *);
+int  select_index_kth(SelectIndex *, int);
+int  select_index_settled(const SelectIndex *);
+
+#endif // SELECT_INDEX_H
@@ -0,0 +1,127 @@
+/*
+ * ===============================================
+ *     Implementation of Streaming Selection
+ * ===============================================
+ */
+
+#include "StreamSelect.h"
+
+void stream_reader_init(StreamReader *reader, FILE *fp) {
+
+    reader->fp = fp;
+    reader->len = 0;
+    reader->pos = 0;
+}
+
+// Returns the next character of the stream, reading a new chunk when the buffer is exhausted
+static int stream_getc(StreamReader *reader) {
+
+    if (reader->pos == reader->len) {
+        reader->len = (int)fread(reader->buffer, 1, STREAM_CHUNK, reader->fp);
+        reader->pos = 0;
+        if (reader->len == 0)
+            return EOF;
+    }
+    return (unsigned char)reader->buffer[reader->pos++];
+}
+
+// Puts back the character just returned by stream_getc, which is still in the buffer
+static void stream_ungetc(StreamReader *reader, int c) {
+
+    if (c != EOF)
+        reader->pos--;
+}
+
+// Reads the next integer of the stream into *value, skipping any separator before it
+// The character that ends a number is left unread, so "3-4" holds 3 then -4
+// Numbers may be split across two chunks, so inputs of any length and layout are accepted
+// Numbers outside the int range are clamped to INT_MIN or INT_MAX
+// Returns 1 if a value was read, 0 at the end of the stream
+int stream_next_int(StreamReader *reader, int *value) {
+
+    int c = stream_getc(reader);
+    int negative = 0;
+
+    for (;;) {
+        if (c == EOF)
+            return 0;
+        if (c >= '0' && c <= '9')
+            break;
+        if (c == '-') {
+            c = stream_getc(reader);
+            if (c >= '0' && c <= '9') {
+                negative = 1;
+                break;
+            }
+            continue;
+        }
+        c = stream_getc(reader);
+    }
+
+    // Stops growing past INT_MAX + 1, so that long digit runs cannot overflow
+    long long number = 0;
+    while (c >= '0' && c <= '9') {
+        if (number <= (long long)INT_MAX + 1)
+            number = number * 10 + (c - '0');
+        c = stream_getc(reader);
+    }
+    stream_ungetc(reader, c);
+
+    if (negative)
+        *value = number > (long long)INT_MAX + 1 ? INT_MIN : (int)-number;
+    else
+        *value = number > INT_MAX ? INT_MAX : (int)number;
+    return 1;
+}
+
+// Selects the kth smallest value of a stream of integers using O(k) memory
+// If the total count n is known (n > 0) and k > n/2, the (n - k + 1)th largest is tracked instead,
+// so the heap never holds more than min(k, n - k + 1) values :
+// a max-heap keeps the k smallest values seen so far, a min-heap the n - k + 1 largest ones
+// If reportEvery > 0, the current root is printed every reportEvery values once the heap is full
+// Returns 1 and sets *result at the end of the stream, 0 if the stream held fewer than k values
+// or, when n > 0, not exactly n values : the kept values would then not hold the kth one
+int stream_select(FILE *in, int kth, long n, long reportEvery, int *result) {
+
+    Heap hp;
+    StreamReader *reader = malloc(sizeof(StreamReader));
+    int keep = kth;
+    int value;
+    long count = 0;
+
+    if (n > 0 && kth > n / 2) {
+        keep = (int)(n - kth + 1);
+        heap_init(&hp, minHeap);
+    } else {
+        heap_init(&hp, maxHeap);
+    }
+    stream_reader_init(reader, in);
+
+    while (stream_next_int(reader, &value)) {
+
+        Node node;
+        node.value = value;
+        node.index = 0;
+
+        if (heap_size(&hp) < keep) {
+            heap_insert(&hp, node);
+        } else if ((hp.type == maxHeap && value < heap_get_root(&hp).value) ||
+                   (hp.type == minHeap && value > heap_get_root(&hp).value)) {
+            // The root is no longer among the kept values : replace it
+            heap_extract(&hp);
+            heap_insert(&hp, node);
+        }
+
+        count++;
+        if (reportEvery > 0 && count % reportEvery == 0 && heap_size(&hp) == keep)
+            printf("%ld\t%d\n", count, heap_get_root(&hp).value);
+    }
+
+    int found = (keep > 0 && heap_size(&hp) == keep && (n <= 0 || count == n));
+    if (found)
+        *result = heap_get_root(&hp).value;
+
+    free(hp.data);
+    free(reader);
+    return found;
+}
@@ -0,0 +1,22 @@
+#ifndef STREAM_SELECT_H
+#define STREAM_SELECT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include "HeapSelect.h"
+
+#define STREAM_CHUNK 65536
+
+struct _streamReader {
+    FILE *fp;
+    char buffer[STREAM_CHUNK];
+    int len;
+    int pos;
+}; typedef struct _streamReader StreamReader;
+
+void stream_reader_init(StreamReader *, FILE *);
+int  stream_next_int(StreamReader *, int *);
+int  stream_select(FILE *, int, long, long, int *);
+
+#endif // STREAM_SELECT_H
@@ -90,43 +90,163 @@ void compute_standardDeviation(double *arr, int arr_len){
     arr[1] = standardDeviation;
 }
 
-// This function takes a function as a parameter (quick_select, median_select or heap_select)
-// so that the time estimation's code doesn't have to be repeated multiple times
-double_t compute_selection_timings(int (*f)(int *, int, int, int), int *arr, int arrLen, int kth) {
+// Hardware counters of the last compute_selection_timings call, per call and net of the
+// initialization like the returned time; NAN for the counters that are not available
+// Per thread, like the counters themselves, so that benchmark workers measure their own calls
+_Thread_local double timingCounters[PERF_COUNTERS] = {NAN, NAN, NAN, NAN, NAN, NAN};
+_Thread_local int    timingCountersEnabled = 0;
+
+// Enables the counters of compute_selection_timings for the calling thread
+// Returns the number of counters available : with none, only time is measured
+// Disabling them closes the calling thread's counters
+int compute_enable_counters(int enable) {
+
+    timingCountersEnabled = 0;
+    if (!enable)
+        perf_close();
+    if (enable) {
+        int available = perf_open();
+        if (available == 0)
+            fprintf(stderr, "Performance counters unavailable, measuring time only\n");
+        timingCountersEnabled = available > 0;
+        return available;
+    }
+    return 0;
+}
+
+// Copies the counters of the last compute_selection_timings call to counters[PERF_COUNTERS]
+void compute_last_counters(double *counters) {
+
+    memcpy(counters, timingCounters, sizeof(timingCounters));
+}
+
+// Computes the system's resolution if it is not known yet
+// Must be called before timing from several threads, which would otherwise all compute it
+void compute_prepare(void) {
 
     if (systemResolution == -1) {
         fprintf(stderr, "Computing system's resolution...\n");
         systemResolution = compute_sysResolution();
         value = systemResolution * ((1 / PERCENTAGE_ERROR) + 1);
     }
+}
+
+// Times repeated calls of the given selection function with the given "mode"
+// Calls are repeated until the measured interval exceeds the precision threshold
+// When counters is not NULL and counters are enabled, it receives their mean count per call
+// Returns the mean duration of a single call
+static double_t compute_mode_timings(int (*f)(int *, int, int, int), int *arr, int arrLen, int kth, int mode,
+                                     double *counters) {
+
+    compute_prepare();
 
-    double_t fullTime = 0; double_t initTime = 0;
     struct timespec tick, tock;
+    int counting = counters != NULL && timingCountersEnabled;
 
-    // For cycle is used to calculate the duration of the entirety of the algorithm first
+    if (counting) {
+        memset(counters, 0, PERF_COUNTERS * sizeof(double));
+        perf_start();
+    }
+    clock_gettime(CLOCK_MONOTONIC, &tick);
+    int count = 0;
+    do {
+        (*f)(arr, arrLen, kth, mode);
+        clock_gettime(CLOCK_MONOTONIC, &tock);
+        count++;
+    } while (compute_execTime(tick, tock) <= value);
+    if (counting) {
+        perf_stop(counters);
+        for (int i = 0; i < PERF_COUNTERS; i++) {
+            counters[i] /= count;
+        }
+    }
+
+    return (compute_execTime(tick, tock)) / count;
+}
+
+// This function takes a function as a parameter (quick_select, median_select, heap_select, intro_select ...)
+// so that the time estimation's code doesn't have to be repeated multiple times
+double_t compute_selection_timings(int (*f)(int *, int, int, int), int *arr, int arrLen, int kth) {
+
+    double fullCounters[PERF_COUNTERS];
+    double initCounters[PERF_COUNTERS];
+
+    // The duration of the entirety of the algorithm is calculated first
     // and only the initialization of data structures second
     // "mode" int is used to switch between the two scenarios
     // All selection algorithms have been modified to allow such behavior
-    int mode = 0;
-    for (int i = 0; i<2; i++) {
-
-        clock_gettime(CLOCK_MONOTONIC, &tick);
-        int count = 0;
-        do {
-            (*f)(arr, arrLen, kth, mode);
-            clock_gettime(CLOCK_MONOTONIC, &tock);
-            count++;
-        } while (compute_execTime(tick, tock) <= value);
-
-        if (mode == 0) {
-            fullTime = (compute_execTime(tick, tock)) / count;
-        } else if (mode == 1) {
-            initTime = (compute_execTime(tick, tock)) / count;
-        }
+    double_t fullTime = compute_mode_timings(f, arr, arrLen, kth, 0, fullCounters);
+    double_t initTime = compute_mode_timings(f, arr, arrLen, kth, 1, initCounters);
 
-        mode++;
+    for (int i = 0; i < PERF_COUNTERS; i++) {
+        timingCounters[i] = (timingCountersEnabled && perf_available((enum perfCounter)i))
+                            ? fullCounters[i] - initCounters[i] : NAN;
     }
 
     double_t execTime = fullTime - initTime;
     return execTime;
 }
+
+// Returns the duration of the initialization alone (mode 1), which compute_selection_timings discards
+// For quick_select and median_select this is the cost of allocating, copying and freeing the input
+double_t compute_copy_timings(int (*f)(int *, int, int, int), int *arr, int arrLen, int kth) {
+
+    return compute_mode_timings(f, arr, arrLen, kth, 1, NULL);
+}
+
+/*
+ * ===============================================
+ *      Adapters for the zero-copy variants
+ * ===============================================
+ */
+
+// Scratch buffer shared by the adapters below, it only grows so that repeated calls do no allocation
+// One per thread, so that benchmark workers do not share it
+_Thread_local int *timingScratch = NULL;
+_Thread_local int  timingScratchLen = 0;
+
+static int *time_scratch(int arrLen) {
+
+    if (timingScratchLen < arrLen) {
+        free(timingScratch);
+        timingScratch = malloc(arrLen * sizeof(int));
+        timingScratchLen = arrLen;
+    }
+    return timingScratch;
+}
+
+// Releases what the calling thread's timings hold : the scratch buffer and the counters
+// Must be called by benchmark threads before they exit, these being per thread
+void compute_release(void) {
+
+    free(timingScratch);
+    timingScratch = NULL;
+    timingScratchLen = 0;
+    compute_enable_counters(0);
+}
+
+// Same signature as the other selection algorithms, so it can be given to compute_selection_timings
+// Mode 1 only copies the input to the reusable scratch buffer
+int time_quick_scratch(int *arr, int arrLen, int kth, int mode) {
+
+    int *scratch = time_scratch(arrLen);
+
+    if (mode == 0) {
+        return quick_select_scratch(arr, arrLen, kth, scratch);
+    }
+    memcpy(scratch, arr, arrLen * sizeof(int));
+    return 0;
+}
+
+// Same signature as the other selection algorithms, so it can be given to compute_selection_timings
+// Mode 1 only copies the input to the reusable scratch buffer
+int time_median_scratch(int *arr, int arrLen, int kth, int mode) {
+
+    int *scratch = time_scratch(arrLen);
+
+    if (mode == 0) {
+        return median_select_scratch(arr, arrLen, kth, scratch);
+    }
+    memcpy(scratch, arr, arrLen * sizeof(int));
+    return 0;
+}
@@ -7,12 +7,25 @@
 #include "QuickSelect.h"
 #include "MedianSelect.h"
 #include "HeapSelect.h"
+#include "IntroSelect.h"
+#include "FloydSelect.h"
+#include "MultiSelect.h"
+#include "StreamSelect.h"
+#include "RunningSelect.h"
+#include "ExternalSelect.h"
+#include "PerfCounters.h"
 
 double_t compute_sysResolution();
 void     time_insertionSort(double_t *, int);
 double_t compute_execTime(struct timespec, struct timespec);
 void     compute_standardDeviation(double *, int);
+void     compute_prepare(void);
+int      compute_enable_counters(int);
+void     compute_last_counters(double *);
+void     compute_release(void);
 double_t compute_selection_timings(int (*f)(int *, int, int, int), int *, int, int);
-
+double_t compute_copy_timings(int (*f)(int *, int, int, int), int *, int, int);
+int      time_quick_scratch(int *, int, int, int);
+int      time_median_scratch(int *, int, int, int);
 
 #endif //TIME_TIME_H
@@ -0,0 +1,119 @@
+/*
+ * ===============================================
+ *    Top-k : the k Smallest or Largest Values
+ * ===============================================
+ */
+
+#include "TopSelect.h"
+
+// top_k keeps a heap of k values when k <= arrLen / TOP_HEAP_DIVISOR and partitions otherwise
+#define TOP_HEAP_DIVISOR 64
+
+static int top_ascending(const void *a, const void *b) {
+
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+static int top_descending(const void *a, const void *b) {
+
+    return top_ascending(b, a);
+}
+
+// Clamps k to [0, arrLen]
+static int top_count(int arrLen, int k) {
+
+    if (k < 0)
+        return 0;
+    return k < arrLen ? k : arrLen;
+}
+
+// Writes the k smallest values of arr to out, or the k largest if largest is set,
+// keeping them in a heap of k nodes as stream_select does : a max-heap of the smallest values
+// seen so far, whose root is replaced whenever a smaller value shows up (a min-heap for the largest)
+// Sorted output is obtained by extracting the roots, from the back of out
+// O(n log k) worst case, close to O(n) for random input, and the array is never copied
+// Returns the number of values written, min(k, arrLen)
+int top_k_heap(const int *arr, int arrLen, int k, int largest, enum topOrder order, int *out) {
+
+    k = top_count(arrLen, k);
+    if (k == 0)
+        return 0;
+
+    Heap hp;
+    heap_init(&hp, largest ? minHeap : maxHeap);
+    heap_resize(&hp, k);
+
+    for (int i = 0; i < arrLen; i++) {
+        Node node;
+        node.value = arr[i];
+        node.index = i;
+
+        if (heap_size(&hp) < k) {
+            heap_insert(&hp, node);
+        } else if ((hp.type == maxHeap && arr[i] < hp.data[0].value) ||
+                   (hp.type == minHeap && arr[i] > hp.data[0].value)) {
+            // The root is no longer among the kept values : replace it
+            hp.data[0] = node;
+            heap_Heapify_down(&hp, 0);
+        }
+    }
+
+    if (order == topSorted) {
+        for (int i = k - 1; i >= 0; i--) {
+            out[i] = heap_get_root(&hp).value;
+            heap_extract(&hp);
+        }
+    } else {
+        for (int i = 0; i < k; i++) {
+            out[i] = hp.data[i].value;
+        }
+    }
+
+    free(hp.data);
+    return k;
+}
+
+// Writes the k smallest values of arr to out, or the k largest if largest is set
+// Partitions a copy with intro_rec (quick_partition steps, set_median after repeated stalls)
+// so that the k values end up at one end of it, then sorts only those if asked to
+// O(n + k log k) with sorted output, O(n) without
+// Returns the number of values written, min(k, arrLen)
+int top_k_partition(const int *arr, int arrLen, int k, int largest, enum topOrder order, int *out) {
+
+    k = top_count(arrLen, k);
+    if (k == 0)
+        return 0;
+
+    int *arr_cpy = malloc(arrLen * sizeof(int));
+    memcpy(arr_cpy, arr, arrLen * sizeof(int));
+
+    // Everything left of the selected rank is smaller or equal to it, everything right of it greater or equal
+    if (largest) {
+        if (k < arrLen)
+            intro_rec(arr_cpy, 0, arrLen - 1, arrLen - k + 1);
+        memcpy(out, arr_cpy + arrLen - k, k * sizeof(int));
+    } else {
+        if (k < arrLen)
+            intro_rec(arr_cpy, 0, arrLen - 1, k);
+        memcpy(out, arr_cpy, k * sizeof(int));
+    }
+    free(arr_cpy);
+
+    if (order == topSorted)
+        qsort(out, k, sizeof(int), largest ? top_descending : top_ascending);
+    return k;
+}
+
+// Writes the k smallest values of arr to out, or the k largest if largest is set
+// Sorted output is increasing for the smallest values and decreasing for the largest ones
+// Small k relative to arrLen are served by the bounded heap, the others by partitioning
+// Does not modify the array
+// Returns the number of values written, min(k, arrLen)
+int top_k(const int *arr, int arrLen, int k, int largest, enum topOrder order, int *out) {
+
+    if (k <= arrLen / TOP_HEAP_DIVISOR)
+        return top_k_heap(arr, arrLen, k, largest, order, out);
+    return top_k_partition(arr, arrLen, k, largest, order, out);
+}
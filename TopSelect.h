@@ -0,0 +1,17 @@
+#ifndef TOP_SELECT_H
+#define TOP_SELECT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "HeapSelect.h"
+#include "IntroSelect.h"
+
+// Order of the values top_k writes
+enum topOrder {topUnsorted = 0, topSorted = 1};
+
+int top_k_heap(const int *, int, int, int, enum topOrder, int *);
+int top_k_partition(const int *, int, int, int, enum topOrder, int *);
+int top_k(const int *, int, int, int, enum topOrder, int *);
+
+#endif // TOP_SELECT_H
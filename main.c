@@ -2,6 +2,7 @@
  * ===============================================
  * 	     Time Estimation Program applied to
  *    Quick Select, Median Select, Heap Select
+ *           Intro Select, Floyd-Rivest Select
  * ===============================================
  */
 
@@ -9,32 +10,11 @@
 // It's preferable to increase the program's priority in order to decrease the jitter caused by interrupts,
 // I/0 and other processes. To achieve this, run the compiled file with the following code :
 // sudo nice -n, --adjustment =-19 "NAME OF COMPILED FILE"
+// ParallelSelect.c relies on POSIX threads : link with -pthread
 
-#define _GNU_SOURCE
-#include <sched.h>
 #include "Time.h"
-
-// At least two tests MUST be performed at all times
-#define SAME_ARRAY_TESTS 100
-#define DIFFERENT_ARRAY_TESTS 100
-
-void print_to_file(int n, int k, double t1, double d1, double t2, double d2, double t3, double d3){
-
-    FILE *outputFile;
-    outputFile = fopen("results.txt", "a");
-    if(outputFile == NULL)
-        exit(EXIT_FAILURE);
-    fprintf(outputFile,
-            "%d\t%d\t%0.9lf\t%0.9lf\t%0.9lf\t%0.9lf\t%0.9lf\t%0.9lf\n",
-            n, k, t1, d1, t2, d2, t3, d3);
-    fclose(outputFile);
-}
-
-void print_to_screen(int n, int k, double t1, double d1, double t2, double d2, double t3, double d3) {
-
-    printf("N : %d\tK : %d\tT1 : %0.9lf\tD1 : %0.9lf\tT2 : %0.9lf\tD2 : %0.9lf\tT3 : %0.9lf\tD3 : %0.9lf\n",
-           n, k, t1, d1, t2, d2, t3, d3);
-}
+#include "Bench.h"
+#include "Driver.h"
 
 void seed_rand() {
 
@@ -46,92 +26,127 @@ void seed_rand() {
     srand(seed);
 }
 
-int main() {
-
-    // In order to decrease the amount of trashing caused by the program switching cores
-    // and thus invalidating L1 and L2 cache, the process' affinity is set to core 0
-    cpu_set_t my_set;
-    CPU_ZERO(&my_set);
-    CPU_SET(0, &my_set);
-    sched_setaffinity(getpid(), sizeof(cpu_set_t), &my_set);
-
-    double quick_timings[DIFFERENT_ARRAY_TESTS];
-    double heap_timings[DIFFERENT_ARRAY_TESTS];
-    double median_timings[DIFFERENT_ARRAY_TESTS];
-
-    seed_rand();
-
-    // ================================================================================
-    // This section can be modified at will based on the test one is about to perform
-    // ================================================================================
-
-    int exponent = 0;
-    int arrLen = 100;
-
-
-    // Used to create multiple tests following a specific progression of values
-    while (arrLen < 120) {
-
-        int kth = arrLen/2;
-        int index = 0;
-        // Multiple tests are performed in order to create a monotonic function from the computed results
-        // Assumes the size of the array is not modified between tests, but its values are
-        for (int i = 0; i < DIFFERENT_ARRAY_TESTS; i++) {
-
-            // Creates an array of random values
-            int rndMax = arrLen/2;
-            int rndMin = (arrLen/2) * (-1);
-            int *arr = malloc(arrLen * sizeof(int));
-            for (int m = 0; m < arrLen; m++) {
-                arr[m] = (rand() % (rndMax - rndMin + 1)) + rndMin;
-            }
-
-    // ================================================================================
-
-            // Multiple tests are performed in order to reduce jitter caused by the system as much as possible
-            // Assumes the size of the array and its values are not modified between tests
-            // A mean value of all the timings is calculated thereafter
-            double_t quickTimings = 0; double_t heapTimings = 0; double_t medianTimings = 0;
-            for (int j = 0; j < SAME_ARRAY_TESTS; j++) {
-
-                // QUICK SELECT TIME ESTIMATION
-                quickTimings  += compute_selection_timings(quick_select, arr, arrLen, kth);
-
-                // HEAP SELECT TIME ESTIMATION
-                heapTimings   += compute_selection_timings(heap_select, arr, arrLen, kth);
-
-                // MEDIAN SELECT TIME ESTIMATION
-                medianTimings += compute_selection_timings(median_select, arr, arrLen, kth);
-
-            }
-
-
-            quick_timings[index] = (quickTimings/SAME_ARRAY_TESTS);
-            heap_timings[index] = (heapTimings/SAME_ARRAY_TESTS);
-            median_timings[index] = (medianTimings/SAME_ARRAY_TESTS);
-
-            index++;
-
-            free(arr);
+int main(int argc, char **argv) {
+
+    // Optional benchmarks, dispatched before the process is pinned to core 0
+    // e.g. "./a.out kernels 1000000" or "./a.out scaling 100000000 64"
+    // "./a.out heaps [MIN] [MAX]" compares the binary and d-ary heap backends of heap_select
+    // "./a.out arena N" reports time and allocations of heap_select with and without a heap arena
+    // "./a.out sketch N [EPS]" compares the KLL quantile sketch with quick_select
+    // "./a.out stream K [N] [EVERY]" selects the kth smallest value of stdin with O(k) memory
+    // "./a.out distinct N" compares two-way and three-way partitioning on duplicate-heavy arrays
+    // "./a.out segments G L" compares per-group quick_select with segmented_select on G groups of average length L
+    // "./a.out top N" compares the heap walk and partitioning top-k strategies with a full qsort
+    // "./a.out index N Q" answers Q random ranks on the same array with quick_select and with a selection index
+    // "./a.out order N STEPS" interleaves updates and rank queries on an order-statistic tree and on the selectors
+    // "./a.out radix N" compares radix_select with quick_select and intro_select over several value ranges
+    // "./a.out column-write FILE N" writes N generated values to a binary column file
+    // "./a.out column-convert FILE" converts the ints of stdin to a binary column file
+    // "./a.out column FILE K" runs the selectors directly on the mapped column file
+    // "./a.out external FILE K [BUDGET]" selects the kth smallest int of a binary file holding at most BUDGET values in memory
+    if (argc > 2 && strcmp(argv[1], "kernels") == 0) {
+        seed_rand();
+        bench_partition_kernels(atoi(argv[2]));
+        return 0;
+    }
+    if (argc > 2 && strcmp(argv[1], "scaling") == 0) {
+        seed_rand();
+        bench_parallel_scaling(atoi(argv[2]), argc > 3 ? atoi(argv[3]) : 0);
+        return 0;
+    }
+    if (argc > 1 && strcmp(argv[1], "heaps") == 0) {
+        seed_rand();
+        bench_heap_backends(argc > 2 ? atoi(argv[2]) : 1000, argc > 3 ? atoi(argv[3]) : 100000000);
+        return 0;
+    }
+    if (argc > 2 && strcmp(argv[1], "arena") == 0) {
+        seed_rand();
+        bench_heap_arena(atoi(argv[2]));
+        return 0;
+    }
+    if (argc > 2 && strcmp(argv[1], "sketch") == 0) {
+        seed_rand();
+        bench_sketch(atoi(argv[2]), argc > 3 ? atof(argv[3]) : 0.01);
+        return 0;
+    }
+    if (argc > 2 && strcmp(argv[1], "stream") == 0) {
+        int result;
+        long n = argc > 3 ? atol(argv[3]) : 0;
+        long every = argc > 4 ? atol(argv[4]) : 0;
+        if (!stream_select(stdin, atoi(argv[2]), n, every, &result)) {
+            fprintf(stderr, "Fewer than K values were read, or not N of them\n");
+            return EXIT_FAILURE;
         }
+        printf("%d\n", result);
+        return 0;
+    }
+    if (argc > 2 && strcmp(argv[1], "distinct") == 0) {
+        seed_rand();
+        bench_distinct(atoi(argv[2]));
+        return 0;
+    }
+    if (argc > 3 && strcmp(argv[1], "segments") == 0) {
+        seed_rand();
+        bench_segmented(atoi(argv[2]), atoi(argv[3]));
+        return 0;
+    }
+    if (argc > 2 && strcmp(argv[1], "top") == 0) {
+        seed_rand();
+        bench_top(atoi(argv[2]));
+        return 0;
+    }
+    if (argc > 3 && strcmp(argv[1], "index") == 0) {
+        seed_rand();
+        bench_index(atoi(argv[2]), atoi(argv[3]));
+        return 0;
+    }
+    if (argc > 3 && strcmp(argv[1], "order") == 0) {
+        seed_rand();
+        bench_order(atoi(argv[2]), atoi(argv[3]));
+        return 0;
+    }
+    if (argc > 2 && strcmp(argv[1], "radix") == 0) {
+        seed_rand();
+        bench_radix(atoi(argv[2]));
+        return 0;
+    }
+    if (argc > 3 && strcmp(argv[1], "column-write") == 0) {
+        seed_rand();
+        bench_column_write(argv[2], atoi(argv[3]));
+        return 0;
+    }
+    if (argc > 2 && strcmp(argv[1], "column-convert") == 0) {
+        if (!column_write_stream(argv[2], stdin, 4096)) {
+            fprintf(stderr, "Cannot write %s\n", argv[2]);
+            return EXIT_FAILURE;
+        }
+        return 0;
+    }
+    if (argc > 3 && strcmp(argv[1], "column") == 0) {
+        bench_column(argv[2], atoi(argv[3]));
+        return 0;
+    }
+    if (argc > 3 && strcmp(argv[1], "external") == 0) {
+        int result;
+        ExternalStats stats;
+        long long budget = argc > 4 ? atoll(argv[4]) : (1LL << 24);
+        if (!external_select_file(argv[2], atoll(argv[3]), budget, &stats, &result)) {
+            fprintf(stderr, "Cannot read the file or K is out of range\n");
+            return EXIT_FAILURE;
+        }
+        external_print_stats(&stats);
+        printf("%d\n", result);
+        return 0;
+    }
 
-        compute_standardDeviation(quick_timings, DIFFERENT_ARRAY_TESTS);
-        compute_standardDeviation(heap_timings, DIFFERENT_ARRAY_TESTS);
-        compute_standardDeviation(median_timings, DIFFERENT_ARRAY_TESTS);
-
-        double t1 = quick_timings[0] ; double d1 = quick_timings[1];
-        double t2 = heap_timings[0]  ; double d2 = heap_timings[1];
-        double t3 = median_timings[0]; double d3 = median_timings[1];
-
-        print_to_file (arrLen, kth, t1, d1, t2, d2, t3, d3);
-        print_to_screen (arrLen, kth, t1, d1, t2, d2, t3, d3);
-
+    // Without a benchmark command, the options configure the time loop (see driver_usage)
+    // e.g. "./a.out --min 1000 --max 1000000000 --factor 1.5 --algos quick,intro --format json"
+    DriverConfig config;
+    if (!driver_parse(&config, argc, argv))
+        return EXIT_FAILURE;
 
-        // while cycle's guard
-        exponent++;
-        arrLen += 1;
-        //arrLen = 100 * pow( 1.5, exponent );
-    }
+    // The main thread is pinned by driver_run, after the thread pool is created (see driver_setup_affinity)
+    driver_run(&config);
 
     return 0;
-}
\ No newline at end of file
+}